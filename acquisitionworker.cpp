@@ -0,0 +1,360 @@
+#include "acquisitionworker.h"
+#include <QDateTime>
+#include <QDir>
+#include <QRegularExpression>
+#include <QThread>
+#include <QDebug>
+
+AcquisitionWorker::AcquisitionWorker(const QString &portName, QObject *parent)
+    : QObject(parent)
+    , m_portName(portName)
+{
+}
+
+AcquisitionWorker::~AcquisitionWorker()
+{
+    closePort();
+}
+
+void AcquisitionWorker::openPort()
+{
+    qDebug() << "AcquisitionWorker::openPort - Thread ID:" << QThread::currentThreadId();
+
+    if (isReplaySource()) {
+        openReplay();
+        return;
+    }
+
+    if (!m_serial) {
+        // Port nesnesi bu thread'de oluşturulmalı ki readyRead burada işlensin
+        m_serial = new QSerialPort(this);
+        m_serial->setPortName(m_portName);
+        m_serial->setBaudRate(375000);
+        m_serial->setDataBits(QSerialPort::Data8);
+        m_serial->setParity(QSerialPort::OddParity);
+        m_serial->setStopBits(QSerialPort::OneStop);
+        m_serial->setFlowControl(QSerialPort::NoFlowControl);
+    }
+
+    if (m_serial->isOpen()) {
+        emit portStateChanged(true);
+        return;
+    }
+
+    if (!m_serial->open(QIODevice::ReadWrite)) {
+        qWarning() << "openPort(): açılamadı:" << m_serial->errorString();
+        emit portStateChanged(false);
+        return;
+    }
+
+    // Eski oturumdan kalan yarım paketleri ve filtre geçmişini at
+    m_framer.reset();
+    m_plethFilter.reset();
+
+    if (!m_captureDirectory.isEmpty())
+        openCapture();
+
+    // readyRead bağla (UniqueConnection ile tekrar bağlanmasını önle)
+    connect(m_serial, &QSerialPort::readyRead, this, &AcquisitionWorker::readSerialData, Qt::UniqueConnection);
+
+    qDebug() << m_portName << "açıldı, veri bekleniyor...";
+    // Başlangıç komutu (cihazın protokolüne göre)
+    m_serial->write(QByteArray::fromHex("BF5FFF"));
+    m_serial->flush();
+
+    emit portStateChanged(true);
+}
+
+void AcquisitionWorker::closePort()
+{
+    if (isReplaySource()) {
+        pauseReplay();
+        return;
+    }
+
+    if (m_serial && m_serial->isOpen()) {
+        // Veri tamponlarını temizle
+        m_serial->clear(QSerialPort::Input);
+        m_serial->clear(QSerialPort::Output);
+        disconnect(m_serial, &QSerialPort::readyRead, this, &AcquisitionWorker::readSerialData);
+        m_serial->close();
+        m_framer.reset();
+        m_capture.close();
+        emit portStateChanged(false);
+    }
+}
+
+void AcquisitionWorker::readSerialData()
+{
+    if (!m_serial || !m_serial->isOpen())
+        return;
+
+    const quint64 discardedBefore = m_framer.discardedBytes();
+
+    // Veriyi ara kopya olmadan doğrudan paket halkasına oku ve tam paketleri işle
+    // Paket yapısı: AA55 LEN CODE ... CHECKSUM
+    while (m_serial->bytesAvailable() > 0) {
+        const qint64 n = m_serial->read(m_framer.writePtr(), m_framer.writableSize());
+        if (n <= 0) break;
+        if (m_capture.isOpen())
+            m_capture.append(m_framer.writePtr(), static_cast<int>(n));
+        m_framer.commit(static_cast<int>(n));
+        m_framer.drain([this](const PacketView &packet) { processPacket(packet); });
+    }
+
+    flushSamples();
+    publishCounters(discardedBefore);
+}
+
+int AcquisitionWorker::consume(const char *data, int size)
+{
+    const quint64 discardedBefore = m_framer.discardedBytes();
+    const int packets = m_framer.feed(data, size, [this](const PacketView &packet) { processPacket(packet); });
+    flushSamples();
+    publishCounters(discardedBefore);
+    return packets;
+}
+
+void AcquisitionWorker::publishCounters(quint64 discardedBefore)
+{
+    m_discardedBytes.store(m_framer.discardedBytes(), std::memory_order_relaxed);
+    m_checksumErrors.store(m_framer.checksumErrors(), std::memory_order_relaxed);
+
+    const quint64 discarded = m_framer.discardedBytes() - discardedBefore;
+    if (discarded > 0) {
+        qWarning() << "AcquisitionWorker: senkronizasyon için" << discarded << "bayt atıldı"
+                   << "(toplam:" << m_framer.discardedBytes()
+                   << ", checksum hatası:" << m_framer.checksumErrors() << ")";
+    }
+}
+
+void AcquisitionWorker::processPacket(const PacketView &packet)
+{
+    // Senkron ve checksum kontrolü PacketFramer tarafından yapıldı
+    if (packet.size < 5) return;
+
+    // Alan konumları ve sentinel değerleri biolightprotocol.h'deki tablodan
+    Biolight::Decoded decoded;
+    if (!Biolight::decode(packet, decoded)) {
+        m_unknownPackets.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    AcquiredSample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    sample.fields = decoded.present;
+
+    // Ham pleth değeri; filtre zinciri flushSamples'da blok olarak uygulanır
+    sample.waveform = static_cast<qint16>(decoded.value(Biolight::Pleth));
+    sample.spo2 = static_cast<qint16>(decoded.value(Biolight::Spo2));
+    sample.pr = static_cast<qint16>(decoded.value(Biolight::PulseRate));
+    sample.perfusion = static_cast<qint16>(qMin(decoded.value(Biolight::PerfusionIndex), 0x7FFF));
+    sample.status = static_cast<qint16>(decoded.value(Biolight::StatusFlags));
+    sample.probeOff = decoded.value(Biolight::ProbeOff, 0) > 0;
+
+    m_block[m_blockSize++] = sample;
+    if (m_blockSize == SampleBlock)
+        flushSamples();
+}
+
+void AcquisitionWorker::flushSamples()
+{
+    if (m_blockSize == 0)
+        return;
+
+    // Geçerli pleth örneklerini topla, zincirden tek seferde geçir
+    float values[SampleBlock];
+    quint8 kept[SampleBlock];
+    int indices[SampleBlock];
+    int count = 0;
+    for (int i = 0; i < m_blockSize; ++i) {
+        if (m_block[i].has(Biolight::Pleth) && m_block[i].waveform >= 0) {
+            values[count] = m_block[i].waveform;
+            indices[count] = i;
+            ++count;
+        }
+    }
+
+    m_plethFilter.process(values, count, kept);
+
+    // Decimation ile atlanan örnekler waveform taşımaz; diğer alanları korunur
+    int out = 0;
+    for (int i = 0; i < count; ++i) {
+        AcquiredSample &sample = m_block[indices[i]];
+        if (kept[i])
+            sample.waveform = static_cast<qint16>(qBound(0, qRound(values[out++]), 255));
+        else
+            sample.fields &= static_cast<quint16>(~(1u << Biolight::Pleth));
+    }
+
+    // UI yetişemiyorsa örneği düşür ve say (acquisition thread'i asla beklemez)
+    for (int i = 0; i < m_blockSize; ++i) {
+        if (!m_samples.tryPush(m_block[i]))
+            m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_blockSize = 0;
+}
+
+void AcquisitionWorker::setFilterConfig(const PlethFilterConfig &config)
+{
+    flushSamples();
+    m_plethFilter.configure(config);
+    qDebug() << "AcquisitionWorker:" << m_portName << "pleth filtresi -"
+             << "DC:" << config.dcRemoval << "LP:" << config.lowPassHz << "Hz"
+             << "çentik:" << config.notchHz << "Hz" << "decimation:" << config.decimation;
+}
+
+void AcquisitionWorker::sendSetting(quint8 data)
+{
+    if (!m_serial || !m_serial->isOpen()) {
+        qWarning() << "sendSettingToBiolight: seri port kapalı, paket gönderilemedi.";
+        return;
+    }
+
+    // Protokol: AA55 LEN CODE DATA CHECKSUM
+    QByteArray packet;
+    packet.append(static_cast<char>(0xAA));
+    packet.append(static_cast<char>(0x55));
+    quint8 len = 0x02;
+    packet.append(static_cast<char>(len));
+    quint8 code = 0x06;
+    packet.append(static_cast<char>(code));
+    packet.append(static_cast<char>(data));
+    const quint8 body[] = { code, data };
+    quint8 checksum = PacketFramer::checksum(len, body);
+    packet.append(static_cast<char>(checksum));
+
+    qint64 bytesWritten = m_serial->write(packet);
+    m_serial->flush();
+
+    qDebug() << "Biolight ayar paketi gönderildi:" << packet.toHex(' ')
+             << "(" << bytesWritten << "bytes)";
+}
+
+void AcquisitionWorker::setCaptureDirectory(const QString &directory)
+{
+    m_captureDirectory = directory;
+    m_capture.close();
+
+    // Port zaten açıksa kayıt hemen başlar, değilse bir sonraki openPort'ta
+    if (!m_captureDirectory.isEmpty() && m_serial && m_serial->isOpen())
+        openCapture();
+}
+
+void AcquisitionWorker::openCapture()
+{
+    // Her port açılışı ayrı bir oturum dizinine yazılır
+    QString portLabel = m_portName;
+    portLabel.replace(QRegularExpression("[^A-Za-z0-9]+"), "_");
+    const QString session = QStringLiteral("%1_%2").arg(portLabel,
+        QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+
+    if (!m_capture.open(QDir(m_captureDirectory).filePath(session)))
+        qWarning() << "AcquisitionWorker: ham veri kaydı başlatılamadı, kayıt olmadan devam ediliyor";
+}
+
+void AcquisitionWorker::setReplaySpeed(double speed)
+{
+    // Çalışan oynatmayı mevcut konumdan yeni hızla sürdür
+    if (m_replayTimer && m_replayTimer->isActive()) {
+        m_replayBaseNs = replayTargetNs();
+        m_replayClock.restart();
+        m_replayTimer->setInterval(speed > 0.0 ? 10 : 0);
+    }
+    m_replaySpeed = speed;
+}
+
+void AcquisitionWorker::openReplay()
+{
+    if (m_replayTimer && m_replayTimer->isActive()) {
+        emit portStateChanged(true);
+        return;
+    }
+
+    if (!m_replay.isOpen()) {
+        const QString directory = m_portName.mid(static_cast<int>(qstrlen(ReplayScheme)));
+        if (!m_replay.open(directory)) {
+            qWarning() << "openPort(): kayıt açılamadı:" << directory;
+            emit portStateChanged(false);
+            return;
+        }
+
+        m_framer.reset();
+        m_plethFilter.reset();
+        m_hasPendingRecord = m_replay.next(m_pendingRecord);
+        m_replayBaseNs = m_hasPendingRecord ? m_pendingRecord.timestampNs : 0;
+        m_replayBytes = 0;
+        m_replayPackets = 0;
+        m_replayWallClock.start();
+        qDebug() << "Kayıt oynatılıyor:" << directory << "hız:"
+                 << (m_replaySpeed > 0.0 ? QString::number(m_replaySpeed) + "x" : QStringLiteral("azami"));
+    } else if (m_hasPendingRecord) {
+        // Duraklatılan oynatma kaldığı kayıttan devam eder
+        m_replayBaseNs = m_pendingRecord.timestampNs;
+    }
+
+    if (!m_replayTimer) {
+        m_replayTimer = new QTimer(this);
+        m_replayTimer->setTimerType(Qt::PreciseTimer);
+        connect(m_replayTimer, &QTimer::timeout, this, &AcquisitionWorker::replayTick);
+    }
+    m_replayTimer->setInterval(m_replaySpeed > 0.0 ? 10 : 0);
+    m_replayClock.start();
+    m_replayTimer->start();
+
+    emit portStateChanged(true);
+}
+
+void AcquisitionWorker::pauseReplay()
+{
+    if (!m_replayTimer || !m_replayTimer->isActive())
+        return;
+
+    m_replayTimer->stop();
+    emit portStateChanged(false);
+}
+
+qint64 AcquisitionWorker::replayTargetNs() const
+{
+    return m_replayBaseNs + static_cast<qint64>(m_replayClock.nsecsElapsed() * m_replaySpeed);
+}
+
+void AcquisitionWorker::replayTick()
+{
+    if (m_replaySpeed > 0.0) {
+        // Gerçek zaman / N kat: zamanı gelmiş tüm kayıtları, yakalandıkları parçalarla besle
+        const qint64 target = replayTargetNs();
+        while (m_hasPendingRecord && m_pendingRecord.timestampNs <= target) {
+            m_replayBytes += static_cast<quint64>(m_pendingRecord.size);
+            m_replayPackets += static_cast<quint64>(consume(m_pendingRecord.data, m_pendingRecord.size));
+            m_hasPendingRecord = m_replay.next(m_pendingRecord);
+        }
+    } else {
+        // Azami hız: olay döngüsünü (closePort, ayarlar) aç bırakmak için ~20 ms'lik dilimler
+        QElapsedTimer slice;
+        slice.start();
+        while (m_hasPendingRecord && slice.elapsed() < 20) {
+            m_replayBytes += static_cast<quint64>(m_pendingRecord.size);
+            m_replayPackets += static_cast<quint64>(consume(m_pendingRecord.data, m_pendingRecord.size));
+            m_hasPendingRecord = m_replay.next(m_pendingRecord);
+        }
+    }
+
+    if (!m_hasPendingRecord)
+        finishReplay();
+}
+
+void AcquisitionWorker::finishReplay()
+{
+    m_replayTimer->stop();
+
+    const double seconds = qMax<qint64>(1, m_replayWallClock.nsecsElapsed()) / 1e9;
+    qDebug() << "Kayıt oynatma bitti:" << m_replayBytes << "bayt," << m_replayPackets << "paket,"
+             << seconds << "s (" << (m_replayBytes / seconds / 1e6) << "MB/s,"
+             << (m_replayPackets / seconds) << "paket/s ), atılan bayt:" << m_framer.discardedBytes()
+             << ", checksum hatası:" << m_framer.checksumErrors()
+             << ", düşürülen örnek:" << droppedSamples();
+
+    m_replay.close();
+    emit portStateChanged(false);
+}
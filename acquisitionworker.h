@@ -0,0 +1,126 @@
+#ifndef ACQUISITIONWORKER_H
+#define ACQUISITIONWORKER_H
+
+#include <QObject>
+#include <QSerialPort>
+#include <QString>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <atomic>
+#include "biolightprotocol.h"
+#include "capturefile.h"
+#include "dspfilter.h"
+#include "packetframer.h"
+#include "spscqueue.h"
+
+// Acquisition thread'inde çözülen tek bir paket (Biolight::Packets içindeki herhangi bir kod).
+// fields: pakette bulunan Biolight::Field bitleri; yalnızca bunlar geçerlidir.
+struct AcquiredSample {
+    qint64 timestamp = 0;   // milliseconds since epoch
+    quint16 fields = 0;
+    qint16 waveform = -1;   // -1: geçersiz (127 sentinel)
+    qint16 spo2 = -1;
+    qint16 pr = -1;
+    qint16 perfusion = -1;  // 0.01 % birimi
+    qint16 status = -1;     // ham durum baytı
+    bool probeOff = false;
+
+    bool has(Biolight::Field field) const { return fields & (1u << field); }
+};
+
+// Seri port G/Ç'si ve paket çözme işini ayrı bir thread'de yürütür.
+// Çözülen örnekler kilitsiz SPSC kuyruğu ile GUI thread'indeki Reader'a aktarılır.
+// Port adı "replay:<kayıt dizini>" ise seri port yerine ham veri kaydı aynı
+// çözücüden tekrar oynatılır; openPort/closePort oynatmayı başlatır/duraklatır.
+class AcquisitionWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    using SampleQueue = SpscQueue<AcquiredSample, 2048>;
+
+    static constexpr const char *ReplayScheme = "replay:";
+
+    explicit AcquisitionWorker(const QString &portName, QObject *parent = nullptr);
+    ~AcquisitionWorker() override;
+
+    // GUI thread'i tarafından tüketilir (tek tüketici)
+    SampleQueue &samples() { return m_samples; }
+
+    // Herhangi bir thread'den okunabilen sayaçlar
+    quint64 droppedSamples() const { return m_droppedSamples.load(std::memory_order_relaxed); }
+    quint64 discardedBytes() const { return m_discardedBytes.load(std::memory_order_relaxed); }
+    quint64 checksumErrors() const { return m_checksumErrors.load(std::memory_order_relaxed); }
+    // Checksum'ı geçerli ama protokol tablosunda tanımı olmayan paketler
+    quint64 unknownPackets() const { return m_unknownPackets.load(std::memory_order_relaxed); }
+
+    // Seri port dışındaki kaynaklardan (replay, benchmark) gelen baytları aynı
+    // çözücüden geçirir; worker'ın thread'inde çağrılmalıdır. İşlenen paket sayısını döndürür.
+    int consume(const char *data, int size);
+
+public slots:
+    void openPort();
+    void closePort();
+    void sendSetting(quint8 data); // Biolight modülüne ayar gönder
+
+    // Ham veri kaydı: her port açılışında directory altında yeni bir oturum
+    // (<port>_<tarih>) başlar; boş dizin kaydı kapatır
+    void setCaptureDirectory(const QString &directory);
+    // Oynatma hızı: 1 = gerçek zaman, N = N kat, <= 0 = azami hız
+    void setReplaySpeed(double speed);
+    // Pleth filtre zincirini yeniden kurar (durum sıfırlanır)
+    void setFilterConfig(const PlethFilterConfig &config);
+
+signals:
+    void portStateChanged(bool open);
+
+private slots:
+    void readSerialData();
+    void replayTick();
+
+private:
+    void processPacket(const PacketView &packet);
+    void flushSamples();
+    void publishCounters(quint64 discardedBefore);
+
+    bool isReplaySource() const { return m_portName.startsWith(QLatin1String(ReplayScheme)); }
+    void openCapture();
+    void openReplay();
+    void pauseReplay();
+    void finishReplay();
+    qint64 replayTargetNs() const;
+
+    QSerialPort *m_serial = nullptr; // acquisition thread'inde oluşturulur
+    QString m_portName;
+    PacketFramer m_framer;
+
+    // Çözülen paketler blok halinde filtrelenip kuyruğa verilir
+    static constexpr int SampleBlock = 64;
+    AcquiredSample m_block[SampleBlock];
+    int m_blockSize = 0;
+    PlethFilter m_plethFilter; // cihaz başına filtre durumu
+
+    SampleQueue m_samples;
+    std::atomic<quint64> m_droppedSamples{0};
+    std::atomic<quint64> m_discardedBytes{0};
+    std::atomic<quint64> m_checksumErrors{0};
+    std::atomic<quint64> m_unknownPackets{0};
+
+    // Ham veri kaydı (okuma yolunda yalnızca bellek eşlemeli segmente memcpy)
+    QString m_captureDirectory;
+    CaptureWriter m_capture;
+
+    // Kayıttan oynatma
+    CaptureReader m_replay;
+    QTimer *m_replayTimer = nullptr;
+    QElapsedTimer m_replayClock;     // son başlatma/hız değişikliğinden beri
+    QElapsedTimer m_replayWallClock; // oynatmanın toplam süresi (throughput için)
+    double m_replaySpeed = 1.0;
+    qint64 m_replayBaseNs = 0;       // m_replayClock başladığında kayıttaki konum
+    CaptureRecord m_pendingRecord;   // zamanı henüz gelmemiş kayıt
+    bool m_hasPendingRecord = false;
+    quint64 m_replayBytes = 0;
+    quint64 m_replayPackets = 0;
+};
+
+#endif // ACQUISITIONWORKER_H
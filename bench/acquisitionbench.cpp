@@ -0,0 +1,241 @@
+#include "benchreport.h"
+#include "acquisitionworker.h"
+#include "biolightprotocol.h"
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr int FramesPerStream = 200000; // ~2.8 MB, 50 Hz'de ~67 dakikalık veri
+
+// Biolight code-21 paketi: AA55 LEN CODE ... CHECKSUM (LEN = 10)
+void appendFrame(QByteArray &stream, quint8 pleth, quint8 spo2, quint16 pr, bool corrupt)
+{
+    quint8 payload[10] = {};
+    payload[0] = 21;                     // CODE
+    payload[2] = pleth;                  // packet.at(5)
+    payload[4] = spo2;                   // packet.at(7)
+    payload[5] = static_cast<quint8>(pr >> 8);
+    payload[6] = static_cast<quint8>(pr & 0xFF);
+
+    quint8 checksum = PacketFramer::checksum(sizeof(payload), payload);
+    if (corrupt)
+        checksum ^= 0x5A;
+
+    stream.append(static_cast<char>(0xAA));
+    stream.append(static_cast<char>(0x55));
+    stream.append(static_cast<char>(sizeof(payload)));
+    stream.append(reinterpret_cast<const char *>(payload), sizeof(payload));
+    stream.append(static_cast<char>(checksum));
+}
+
+// noiseRatio: paketler arasına rastgele bayt eklenme olasılığı,
+// corruptRatio: checksum'ı bozuk paket oranı
+QByteArray makeStream(double noiseRatio, double corruptRatio, quint32 seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<int> noiseLength(1, 24);
+
+    QByteArray stream;
+    stream.reserve(FramesPerStream * 16);
+    for (int i = 0; i < FramesPerStream; ++i) {
+        if (noiseRatio > 0.0 && chance(rng) < noiseRatio) {
+            const int n = noiseLength(rng);
+            for (int k = 0; k < n; ++k)
+                stream.append(static_cast<char>(byteDist(rng)));
+        }
+        const quint8 pleth = static_cast<quint8>(128 + 100 * std::sin(i * 0.12));
+        appendFrame(stream, pleth, 97, 72, corruptRatio > 0.0 && chance(rng) < corruptRatio);
+    }
+    return stream;
+}
+
+// Akışı verilen parça boyutlarıyla AcquisitionWorker::consume'a verir; kuyruk
+// her parçadan sonra GUI thread'indeki Reader gibi boşaltılır
+void runStream(BenchReport &report, const QString &name, const QByteArray &stream,
+               const QVector<int> &chunkSizes, qint64 minMs, const QJsonObject &params)
+{
+    AcquisitionWorker worker(QStringLiteral("bench"));
+    qint64 packets = 0;
+    qint64 passes = 0;
+
+    const auto pass = [&]() {
+        const char *data = stream.constData();
+        int remaining = stream.size();
+        int chunkIndex = 0;
+        while (remaining > 0) {
+            const int chunk = qMin(remaining, chunkSizes.at(chunkIndex));
+            chunkIndex = (chunkIndex + 1) % chunkSizes.size();
+            packets += worker.consume(data, chunk);
+            worker.samples().drain([](const AcquiredSample &) {});
+            data += chunk;
+            remaining -= chunk;
+        }
+        ++passes;
+    };
+
+    const double ns = BenchReport::nsPerOp(pass, minMs);
+    const double seconds = ns / 1e9;
+    const double packetsPerPass = static_cast<double>(packets) / passes;
+
+    QJsonObject metrics;
+    metrics.insert("bytes_per_sec", stream.size() / seconds);
+    metrics.insert("packets_per_sec", packetsPerPass / seconds);
+    metrics.insert("ns_per_byte", ns / stream.size());
+    metrics.insert("ns_per_packet", ns / qMax(1.0, packetsPerPass));
+    metrics.insert("packets_per_pass", packetsPerPass);
+    metrics.insert("discarded_bytes", static_cast<double>(worker.discardedBytes()) / passes);
+    metrics.insert("checksum_errors", static_cast<double>(worker.checksumErrors()) / passes);
+    metrics.insert("dropped_samples", static_cast<double>(worker.droppedSamples()));
+
+    QJsonObject allParams = params;
+    allParams.insert("stream_bytes", stream.size());
+    report.add("acquisition", name, metrics, allParams);
+}
+
+// Gerçek cihazdan alınmış ham veri kaydını, yakalandığı okuma parçalarıyla azami hızda çözer
+void runCaptureReplay(BenchReport &report, const QString &directory, qint64 minMs)
+{
+    CaptureReader capture;
+    if (!capture.open(directory)) {
+        qCritical() << "Kayıt açılamadı, replay benchmark'ı atlandı:" << directory;
+        return;
+    }
+
+    AcquisitionWorker worker(QStringLiteral("bench"));
+    qint64 bytes = 0;
+    qint64 records = 0;
+    qint64 packets = 0;
+    qint64 passes = 0;
+
+    const double ns = BenchReport::nsPerOp([&]() {
+        capture.rewind();
+        CaptureRecord record;
+        while (capture.next(record)) {
+            packets += worker.consume(record.data, record.size);
+            worker.samples().drain([](const AcquiredSample &) {});
+            bytes += record.size;
+            ++records;
+        }
+        ++passes;
+    }, minMs);
+
+    const double seconds = ns / 1e9;
+    QJsonObject metrics;
+    metrics.insert("bytes_per_sec", bytes / static_cast<double>(passes) / seconds);
+    metrics.insert("packets_per_sec", packets / static_cast<double>(passes) / seconds);
+    metrics.insert("ns_per_pass", ns);
+    metrics.insert("discarded_bytes", static_cast<double>(worker.discardedBytes()) / passes);
+    metrics.insert("checksum_errors", static_cast<double>(worker.checksumErrors()) / passes);
+
+    QJsonObject params;
+    params.insert("capture", directory);
+    params.insert("stream_bytes", static_cast<double>(bytes) / passes);
+    params.insert("records", static_cast<double>(records) / passes);
+    params.insert("segments", capture.segmentCount());
+    report.add("acquisition", "replay_capture", metrics, params);
+}
+
+// Yalnızca protokol tablosu dağıtıcısı: çerçeveleme ve kuyruk hariç, paket başına çözme maliyeti
+void runDecoder(BenchReport &report, qint64 minMs)
+{
+    // 50 Hz parametre paketi + saniyede bir tabloda tanımı olmayan iki kod (bilinmeyen kod yolu)
+    QByteArray frames;
+    for (int i = 0; i < 50; ++i)
+        appendFrame(frames, static_cast<quint8>(i * 5), 97, 72, false);
+    const quint8 perfusion[] = {22, 0x01, 0x5E};
+    const quint8 status[] = {23, 0x00};
+    for (const auto &body : {QByteArray(reinterpret_cast<const char *>(perfusion), sizeof(perfusion)),
+                             QByteArray(reinterpret_cast<const char *>(status), sizeof(status))}) {
+        frames.append(static_cast<char>(0xAA));
+        frames.append(static_cast<char>(0x55));
+        frames.append(static_cast<char>(body.size()));
+        frames.append(body);
+        frames.append(static_cast<char>(PacketFramer::checksum(static_cast<quint8>(body.size()),
+                                         reinterpret_cast<const quint8 *>(body.constData()))));
+    }
+
+    // Paketler zaten çerçeveli; görünümler doğrudan tampon üzerinde
+    QVector<PacketView> views;
+    const quint8 *data = reinterpret_cast<const quint8 *>(frames.constData());
+    for (int offset = 0; offset < frames.size();) {
+        PacketView view;
+        view.data = data + offset;
+        view.size = 2 + 1 + data[offset + 2] + 1;
+        views.append(view);
+        offset += view.size;
+    }
+
+    volatile qint32 sink = 0;
+    const double ns = BenchReport::nsPerOp([&]() {
+        Biolight::Decoded decoded;
+        qint32 sum = 0;
+        for (const PacketView &view : std::as_const(views)) {
+            if (Biolight::decode(view, decoded))
+                sum += decoded.present;
+        }
+        sink = sink + sum;
+    }, minMs);
+
+    QJsonObject metrics;
+    metrics.insert("ns_per_packet", ns / views.size());
+    metrics.insert("packets_per_sec", views.size() / (ns / 1e9));
+
+    QJsonObject params;
+    params.insert("mix", "50x code21, 2x unknown (22, 23)");
+    report.add("acquisition", "decode_dispatch", metrics, params);
+}
+
+void runChecksum(BenchReport &report, int payloadLength, qint64 minMs)
+{
+    QByteArray payload(payloadLength, '\0');
+    for (int i = 0; i < payloadLength; ++i)
+        payload[i] = static_cast<char>(i * 31 + 7);
+    const quint8 *data = reinterpret_cast<const quint8 *>(payload.constData());
+
+    volatile quint8 sink = 0;
+    const double ns = BenchReport::nsPerOp([&]() {
+        sink = sink + PacketFramer::checksum(static_cast<quint8>(payloadLength), data);
+    }, minMs);
+
+    QJsonObject metrics;
+    metrics.insert("ns_per_packet", ns);
+    metrics.insert("bytes_per_sec", payloadLength / (ns / 1e9));
+
+    QJsonObject params;
+    params.insert("payload_bytes", payloadLength);
+    report.add("acquisition", "checksum", metrics, params);
+}
+
+} // namespace
+
+void runAcquisitionBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    const qint64 minMs = options.quick ? 100 : 1000;
+
+    // Temiz akış, QSerialPort'un tipik okuma boyutunda
+    const QByteArray clean = makeStream(0.0, 0.0, 1);
+    runStream(report, "stream_clean", clean, {4096}, minMs, {{"chunk", 4096}});
+
+    // Gürültülü akış: paketlerin %10'u önünde çöp bayt, %2'si bozuk checksum
+    const QByteArray noisy = makeStream(0.10, 0.02, 2);
+    runStream(report, "stream_noisy", noisy, {4096}, minMs,
+              {{"chunk", 4096}, {"noise_ratio", 0.10}, {"corrupt_ratio", 0.02}});
+
+    // Parçalı akış: paketler okuma sınırlarında bölünür (1-13 bayt arası parçalar)
+    QVector<int> fragments;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> fragmentSize(1, 13);
+    for (int i = 0; i < 997; ++i)
+        fragments.append(fragmentSize(rng));
+    runStream(report, "stream_fragmented", clean, fragments, minMs, {{"chunk", "1-13"}});
+
+    if (!options.captureDir.isEmpty())
+        runCaptureReplay(report, options.captureDir, minMs);
+
+    runDecoder(report, minMs / 2);
+    runChecksum(report, 10, minMs / 2);
+    runChecksum(report, 255, minMs / 2);
+}
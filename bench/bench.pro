@@ -0,0 +1,57 @@
+# SpO2 Monitor benchmark paketi (JSON çıktılı)
+TEMPLATE = app
+TARGET = spo2bench
+
+QT += core gui sql serialport quick qml printsupport
+
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+SOURCES += main.cpp \
+    acquisitionbench.cpp \
+    benchreport.cpp \
+    codecbench.cpp \
+    databasebench.cpp \
+    dspbench.cpp \
+    reportbench.cpp \
+    storagebench.cpp \
+    ../acquisitionworker.cpp \
+    ../capturefile.cpp \
+    ../databasereader.cpp \
+    ../databaseworker.cpp \
+    ../dspfilter.cpp \
+    ../notificationscheduler.cpp \
+    ../packetframer.cpp \
+    ../pdfexporter.cpp \
+    ../reader.cpp \
+    ../waveformcodec.cpp \
+    ../waveformhistory.cpp \
+    ../waveformitem.cpp \
+    ../waveformmodel.cpp \
+    ../waveformstatistics.cpp \
+    ../waveformstore.cpp
+
+HEADERS += \
+    benchreport.h \
+    ../acquisitionworker.h \
+    ../biolightprotocol.h \
+    ../capturefile.h \
+    ../databasereader.h \
+    ../databaseworker.h \
+    ../measurementbatch.h \
+    ../dspfilter.h \
+    ../notificationscheduler.h \
+    ../packetframer.h \
+    ../pdfexporter.h \
+    ../reader.h \
+    ../samplering.h \
+    ../spscqueue.h \
+    ../waveformcodec.h \
+    ../waveformhistory.h \
+    ../waveformitem.h \
+    ../waveformmodel.h \
+    ../waveformpyramid.h \
+    ../waveformstatistics.h \
+    ../waveformstore.h
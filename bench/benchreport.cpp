@@ -0,0 +1,103 @@
+#include "benchreport.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QThread>
+#include <QTextStream>
+#include <QDebug>
+
+LatencyStats LatencyStats::fromSamples(QVector<qint64> ns)
+{
+    LatencyStats stats;
+    if (ns.isEmpty())
+        return stats;
+
+    std::sort(ns.begin(), ns.end());
+    double total = 0.0;
+    for (qint64 v : std::as_const(ns))
+        total += static_cast<double>(v);
+
+    const auto percentile = [&ns](double p) {
+        const int index = qBound(0, static_cast<int>(p * (ns.size() - 1) + 0.5), static_cast<int>(ns.size()) - 1);
+        return static_cast<double>(ns.at(index));
+    };
+
+    stats.samples = ns.size();
+    stats.meanNs = total / ns.size();
+    stats.minNs = static_cast<double>(ns.first());
+    stats.p50Ns = percentile(0.50);
+    stats.p99Ns = percentile(0.99);
+    stats.maxNs = static_cast<double>(ns.last());
+    return stats;
+}
+
+QJsonObject LatencyStats::toJson() const
+{
+    QJsonObject obj;
+    obj.insert("samples", samples);
+    obj.insert("mean_ns", meanNs);
+    obj.insert("min_ns", minNs);
+    obj.insert("p50_ns", p50Ns);
+    obj.insert("p99_ns", p99Ns);
+    obj.insert("max_ns", maxNs);
+    return obj;
+}
+
+BenchReport::BenchReport()
+{
+    m_environment.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    m_environment.insert("qt_version", QString::fromLatin1(qVersion()));
+    m_environment.insert("cpu_arch", QSysInfo::currentCpuArchitecture());
+    m_environment.insert("os", QSysInfo::prettyProductName());
+    m_environment.insert("threads", QThread::idealThreadCount());
+#ifdef QT_DEBUG
+    m_environment.insert("build", "debug");
+#else
+    m_environment.insert("build", "release");
+#endif
+}
+
+void BenchReport::add(const QString &group, const QString &name,
+                      const QJsonObject &metrics, const QJsonObject &params)
+{
+    QJsonObject result;
+    result.insert("group", group);
+    result.insert("name", name);
+    if (!params.isEmpty())
+        result.insert("params", params);
+    result.insert("metrics", metrics);
+    m_results.append(result);
+
+    // İlerlemeyi stderr'e yaz (stdout JSON için ayrılmış olabilir)
+    qInfo().noquote() << group + "/" + name
+                      << QJsonDocument(metrics).toJson(QJsonDocument::Compact);
+}
+
+QJsonObject BenchReport::toJson() const
+{
+    QJsonObject root;
+    root.insert("schema", 1);
+    root.insert("environment", m_environment);
+    root.insert("results", m_results);
+    return root;
+}
+
+bool BenchReport::write(const QString &path) const
+{
+    const QByteArray json = QJsonDocument(toJson()).toJson(QJsonDocument::Indented);
+
+    if (path.isEmpty() || path == "-") {
+        QTextStream(stdout) << json;
+        return true;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "BenchReport: dosya açılamadı:" << path << file.errorString();
+        return false;
+    }
+    file.write(json);
+    qInfo() << "BenchReport:" << m_results.size() << "sonuç yazıldı:" << path;
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef BENCHREPORT_H
+#define BENCHREPORT_H
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+
+// Tek bir ölçümün gecikme dağılımı (nanosaniye)
+struct LatencyStats {
+    int samples = 0;
+    double meanNs = 0.0;
+    double minNs = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double maxNs = 0.0;
+
+    static LatencyStats fromSamples(QVector<qint64> ns);
+    QJsonObject toJson() const;
+};
+
+// Benchmark sonuçlarını toplar ve makine tarafından okunabilir JSON olarak yazar.
+// Her sonuç {"group", "name", "params", "metrics"} biçimindedir; derlemeler arasında
+// "group/name" + params anahtarıyla karşılaştırılabilir.
+class BenchReport
+{
+public:
+    BenchReport();
+
+    void add(const QString &group, const QString &name,
+             const QJsonObject &metrics, const QJsonObject &params = QJsonObject());
+
+    QJsonObject toJson() const;
+    bool write(const QString &path) const; // path boşsa stdout
+    int resultCount() const { return m_results.size(); }
+
+    // fn'i en az minMs boyunca tekrar çalıştırır; işlem başına ortalama süreyi (ns) döndürür
+    template <typename Fn>
+    static double nsPerOp(Fn &&fn, qint64 minMs = 200, qint64 *iterations = nullptr);
+
+    // fn'i count kez ayrı ayrı ölçer
+    template <typename Fn>
+    static LatencyStats latency(Fn &&fn, int count);
+
+private:
+    QJsonObject m_environment;
+    QJsonArray m_results;
+};
+
+template <typename Fn>
+double BenchReport::nsPerOp(Fn &&fn, qint64 minMs, qint64 *iterations)
+{
+    fn(); // ısınma
+
+    QElapsedTimer timer;
+    qint64 runs = 0;
+    qint64 batch = 1;
+    timer.start();
+    do {
+        for (qint64 i = 0; i < batch; ++i)
+            fn();
+        runs += batch;
+        batch *= 2;
+    } while (timer.elapsed() < minMs);
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    if (iterations)
+        *iterations = runs;
+    return static_cast<double>(elapsed) / static_cast<double>(runs);
+}
+
+template <typename Fn>
+LatencyStats BenchReport::latency(Fn &&fn, int count)
+{
+    QVector<qint64> samples;
+    samples.reserve(count);
+    QElapsedTimer timer;
+    for (int i = 0; i < count; ++i) {
+        timer.start();
+        fn();
+        samples.append(timer.nsecsElapsed());
+    }
+    return LatencyStats::fromSamples(samples);
+}
+
+// Benchmark grupları (her biri ayrı bir .cpp dosyasında)
+struct BenchOptions {
+    QList<qint64> dbRows;     // veritabanı boyutları
+    bool quick = false;       // CI için kısaltılmış süreler
+    QString captureDir;       // azami hızda oynatılacak ham veri kaydı (isteğe bağlı)
+};
+
+void runAcquisitionBenchmarks(BenchReport &report, const BenchOptions &options);
+void runStorageBenchmarks(BenchReport &report, const BenchOptions &options);
+void runDspBenchmarks(BenchReport &report, const BenchOptions &options);
+void runCodecBenchmarks(BenchReport &report, const BenchOptions &options);
+void runDatabaseBenchmarks(BenchReport &report, const BenchOptions &options);
+void runReportBenchmarks(BenchReport &report, const BenchOptions &options);
+
+#endif // BENCHREPORT_H
@@ -0,0 +1,119 @@
+#include "benchreport.h"
+#include "acquisitionworker.h"
+#include "capturefile.h"
+#include "waveformcodec.h"
+#include <QDebug>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr int BlockSamples = 50 * 10; // varsayılan chunkSeconds ile bir arşiv parçası (50 Hz)
+constexpr int Blocks = 384;
+
+// 50 Hz pleth: ~72/dk nabız, dikrotik çentik harmoniği ve ±1 LSB gürültü
+QByteArray makePleth(int count)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> noise(-1, 1);
+    QByteArray samples(count, Qt::Uninitialized);
+    for (int i = 0; i < count; ++i) {
+        const double beat = i * 0.15;
+        const double value = 128 + 70 * std::sin(beat) + 18 * std::sin(2 * beat + 0.8) + noise(rng);
+        samples[i] = static_cast<char>(qBound(0, static_cast<int>(std::lround(value)), 255));
+    }
+    return samples;
+}
+
+// Kayıttaki geçerli pleth örnekleri (acquisition çözücüsünden geçirilerek)
+QByteArray capturePleth(const QString &directory)
+{
+    QByteArray samples;
+    CaptureReader capture;
+    if (!capture.open(directory)) {
+        qCritical() << "Kayıt açılamadı, codec benchmark'ı sentetik veriyle sürüyor:" << directory;
+        return samples;
+    }
+
+    AcquisitionWorker worker(QStringLiteral("bench"));
+    CaptureRecord record;
+    while (capture.next(record)) {
+        worker.consume(record.data, record.size);
+        worker.samples().drain([&](const AcquiredSample &sample) {
+            if (sample.has(Biolight::Pleth) && sample.waveform >= 0)
+                samples.append(static_cast<char>(sample.waveform));
+        });
+    }
+    return samples;
+}
+
+void runCodec(BenchReport &report, const QString &name, const QByteArray &input, qint64 minMs)
+{
+    // Arşivdeki gibi parça parça kodlanır; her parça bağımsız çözülebilir
+    const int chunks = qMax(1, static_cast<int>(input.size() / BlockSamples));
+    const int chunkSamples = static_cast<int>(input.size() / chunks);
+    const int total = chunks * chunkSamples;
+    const quint8 *source = reinterpret_cast<const quint8 *>(input.constData());
+
+    QVector<QByteArray> encoded(chunks);
+    qint64 encodedBytes = 0;
+    qint64 deflateBytes = 0;
+    for (int c = 0; c < chunks; ++c) {
+        encoded[c] = WaveformCodec::encode(source + c * chunkSamples, chunkSamples);
+        encodedBytes += encoded[c].size();
+        deflateBytes += qCompress(input.mid(c * chunkSamples, chunkSamples)).size();
+    }
+
+    QByteArray scratch(WaveformCodec::maxEncodedSize(chunkSamples), Qt::Uninitialized);
+    const double encodeNs = BenchReport::nsPerOp([&]() {
+        for (int c = 0; c < chunks; ++c)
+            WaveformCodec::encode(source + c * chunkSamples, chunkSamples, reinterpret_cast<quint8 *>(scratch.data()));
+    }, minMs);
+
+    QByteArray decoded(total, Qt::Uninitialized);
+    bool roundTrip = true;
+    const double decodeNs = BenchReport::nsPerOp([&]() {
+        for (int c = 0; c < chunks; ++c) {
+            roundTrip &= WaveformCodec::decode(reinterpret_cast<const quint8 *>(encoded[c].constData()),
+                                               static_cast<int>(encoded[c].size()),
+                                               reinterpret_cast<quint8 *>(decoded.data()) + c * chunkSamples,
+                                               chunkSamples);
+        }
+    }, minMs);
+    roundTrip = roundTrip && decoded == input.left(total);
+
+    const double deflateNs = BenchReport::nsPerOp([&]() {
+        for (int c = 0; c < chunks; ++c)
+            qUncompress(qCompress(input.mid(c * chunkSamples, chunkSamples)));
+    }, minMs / 2);
+
+    QJsonObject metrics;
+    metrics.insert("compression_ratio", static_cast<double>(total) / encodedBytes);
+    metrics.insert("bits_per_sample", 8.0 * encodedBytes / total);
+    metrics.insert("encode_gb_per_sec", total / encodeNs);
+    metrics.insert("decode_gb_per_sec", total / decodeNs);
+    metrics.insert("deflate_compression_ratio", static_cast<double>(total) / deflateBytes);
+    metrics.insert("deflate_roundtrip_gb_per_sec", total / deflateNs);
+    metrics.insert("round_trip_ok", roundTrip);
+
+    QJsonObject params;
+    params.insert("samples", total);
+    params.insert("chunk_samples", chunkSamples);
+    params.insert("block", WaveformCodec::BlockSize);
+    report.add("codec", name, metrics, params);
+}
+
+} // namespace
+
+void runCodecBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    const qint64 minMs = options.quick ? 100 : 500;
+
+    runCodec(report, "pleth_synthetic", makePleth(BlockSamples * Blocks), minMs);
+
+    if (!options.captureDir.isEmpty()) {
+        const QByteArray recorded = capturePleth(options.captureDir);
+        if (!recorded.isEmpty())
+            runCodec(report, "pleth_capture", recorded, minMs);
+    }
+}
@@ -0,0 +1,304 @@
+#include "benchreport.h"
+#include "databaseworker.h"
+#include "databasereader.h"
+#include <QAtomicInt>
+#include <QThread>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+namespace {
+
+const char *const SeedConnection = "spo2bench_seed";
+
+// DatabaseWorker tablolarını oluşturduktan sonra ayrı bir bağlantı ile tek transaction'da
+// rows ölçüm ekler (recursive CTE: satır başına C++ döngüsü yok)
+bool seedMeasurements(qint64 rows, int patients)
+{
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", SeedConnection);
+        db.setDatabaseName("patients.db");
+        if (!db.open()) {
+            qCritical() << "Benchmark veritabanı açılamadı:" << db.lastError().text();
+        } else {
+            QSqlQuery q(db);
+            // Worker bağlantısı açıkken WAL'den çıkılamaz; yalnızca bu bağlantıda fsync kapatılır
+            ok = q.exec("PRAGMA synchronous=OFF");
+            ok = ok && db.transaction();
+            for (int i = 1; ok && i <= patients; ++i) {
+                q.prepare("INSERT INTO patients (first_name, last_name) VALUES (?, ?)");
+                q.addBindValue(QString("Hasta%1").arg(i));
+                q.addBindValue(QString("Soyad%1").arg(i));
+                ok = q.exec();
+            }
+            if (ok) {
+                q.prepare("WITH RECURSIVE seq(n) AS (SELECT 0 UNION ALL SELECT n + 1 FROM seq WHERE n + 1 < ?) "
+                          "INSERT INTO measurements (patient_id, spo2, pr, timestamp_ms) "
+                          "SELECT 1 + n % ?, 85 + n % 15, 50 + (n * 7) % 70, ? - n * 1000 FROM seq");
+                q.addBindValue(rows);
+                q.addBindValue(patients);
+                q.addBindValue(QDateTime::currentMSecsSinceEpoch());
+                ok = q.exec();
+            }
+            if (!ok)
+                qCritical() << "Benchmark verisi eklenemedi:" << q.lastError().text();
+            ok = ok && db.commit();
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(SeedConnection);
+    return ok;
+}
+
+void runForSize(BenchReport &report, qint64 rows, bool quick)
+{
+    QFile::remove("patients.db");
+
+    DatabaseWorker worker;
+    worker.initializeDatabase();
+
+    constexpr int Patients = 100;
+    QElapsedTimer seedTimer;
+    seedTimer.start();
+    if (!seedMeasurements(rows, Patients))
+        return;
+    const qint64 seedMs = seedTimer.elapsed();
+
+    QJsonObject params;
+    params.insert("rows", rows);
+    params.insert("patients", Patients);
+
+    // Okumalar uygulamadaki gibi ayrı salt okunur bağlantıdan (burada aynı thread'de, eşzamanlı değil)
+    DatabaseReader reader;
+    reader.initializeDatabase();
+    constexpr int Channel = DatabaseReader::ListChannel;
+
+    // Akış sonuçları: ilk parçanın süresi (çağrı başından), parça sayısı ve en büyük parça
+    QElapsedTimer streamTimer;
+    qint64 firstChunkNs = 0;
+    int loadedRows = 0;
+    int chunks = 0;
+    int maxChunkRows = 0;
+    bool supersedeAfterFirstChunk = false;
+    QObject::connect(&reader, &DatabaseReader::resultChunk,
+                     [&](int, int queryId, int sequence, const MeasurementBatch &data) {
+        if (sequence == 0) {
+            firstChunkNs = streamTimer.nsecsElapsed();
+            // Kullanıcı filtreyi değiştirmiş gibi: akan sorgu eskir
+            if (supersedeAfterFirstChunk)
+                reader.setLatestQuery(Channel, queryId + 1);
+        }
+        ++chunks;
+        maxChunkRows = qMax(maxChunkRows, data.size());
+    });
+    QObject::connect(&reader, &DatabaseReader::resultFinished,
+                     [&loadedRows](int, int, int totalRows, bool) { loadedRows = totalRows; });
+    const auto startStream = [&]() {
+        chunks = 0;
+        maxChunkRows = 0;
+        firstChunkNs = 0;
+        streamTimer.start();
+    };
+    const auto streamMetrics = [&](QJsonObject &metrics) {
+        metrics.insert("first_chunk_ms", firstChunkNs / 1e6);
+        metrics.insert("chunks", chunks);
+        metrics.insert("max_chunk_rows", maxChunkRows);
+    };
+
+    // Tek ölçüm kaydı: her satır kendi transaction'ında (WAL + synchronous=NORMAL)
+    {
+        worker.setIngestPolicy(0, 1);
+        int counter = 0;
+        const LatencyStats stats = BenchReport::latency([&]() {
+            worker.saveMeasurement(1 + counter % Patients, 90 + counter % 10, 60 + counter % 40);
+            ++counter;
+        }, quick ? 20 : 200);
+
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("seed_ms", seedMs);
+        report.add("database", "save_measurement", metrics, params);
+    }
+
+    // Toplu kayıt: kuyruğa alma + parti başına tek transaction (flush aralığı ölçüme girmez)
+    for (int batchSize : {16, 256}) {
+        worker.setIngestPolicy(DatabaseWorker::DefaultFlushIntervalMs, batchSize);
+        const int count = quick ? 2048 : 16384;
+        int batches = 0;
+        const QMetaObject::Connection connection = QObject::connect(
+            &worker, &DatabaseWorker::measurementsSaved, [&batches](int, bool success) { batches += success; });
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; ++i)
+            worker.saveMeasurement(1 + i % Patients, 90 + i % 10, 60 + i % 40);
+        worker.flushMeasurements();
+        const qint64 ns = timer.nsecsElapsed();
+        QObject::disconnect(connection);
+
+        QJsonObject metrics;
+        metrics.insert("rows_per_sec", count / (ns / 1e9));
+        metrics.insert("ns_per_row", static_cast<double>(ns) / count);
+        metrics.insert("batches", batches);
+        QJsonObject batchParams = params;
+        batchParams.insert("batch_size", batchSize);
+        batchParams.insert("inserted_rows", count);
+        report.add("database", "ingest_batched", metrics, batchParams);
+    }
+
+    // Tüm veriyi yükleme: büyük tablolarda yineleme sayısı düşürülür
+    const int loadIterations = rows <= 100000 ? (quick ? 3 : 20) : (rows <= 1000000 ? 3 : 1);
+    {
+        const LatencyStats stats = BenchReport::latency([&]() {
+            startStream();
+            reader.loadAllData(Channel, 0);
+        }, loadIterations);
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("rows_returned", loadedRows);
+        streamMetrics(metrics);
+        report.add("database", "load_all", metrics, params);
+    }
+
+    // İlk parçadan sonra eskiyen akış: çağrının dönme süresi iptalin ne kadar çabuk işlediğini gösterir
+    {
+        supersedeAfterFirstChunk = true;
+        const LatencyStats stats = BenchReport::latency([&]() {
+            reader.setLatestQuery(Channel, 0);
+            startStream();
+            reader.loadAllData(Channel, 0);
+        }, loadIterations);
+        supersedeAfterFirstChunk = false;
+        reader.setLatestQuery(Channel, 0);
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("rows_returned", loadedRows);
+        metrics.insert("chunks", chunks);
+        report.add("database", "load_all_superseded", metrics, params);
+    }
+
+    // Dar filtre: kritik SpO2 aralığı (zaman indeksi taraması, eşleşenler bulundukça akar)
+    {
+        const LatencyStats stats = BenchReport::latency([&]() {
+            startStream();
+            reader.loadFilteredData(Channel, 0, 85, 88, 50, 120);
+        }, loadIterations);
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("rows_returned", loadedRows);
+        streamMetrics(metrics);
+        QJsonObject filterParams = params;
+        filterParams.insert("filter", "spo2 85-88, pr 50-120");
+        report.add("database", "load_filtered", metrics, filterParams);
+    }
+
+    // Keyset sayfası: ilk sayfa ve tablonun ortasındaki bir imleçten sonraki sayfa; süre
+    // tablo boyutundan bağımsız olmalı
+    {
+        constexpr int PageSize = 100;
+        int pageRows = 0;
+        const QMetaObject::Connection connection = QObject::connect(
+            &reader, &DatabaseReader::pageLoaded,
+            [&pageRows](int, int, const MeasurementBatch &rows, bool) { pageRows = rows.size(); });
+
+        const qint64 middleMs = QDateTime::currentMSecsSinceEpoch() - rows / 2 * 1000;
+        const struct {
+            const char *name;
+            qint64 cursorMs;
+            int spo2Min, spo2Max;
+        } pages[] = {
+            {"load_page_first", DatabaseReader::FirstPageCursor, 0, 0},
+            {"load_page_middle", middleMs, 0, 0},
+            {"load_page_filtered_middle", middleMs, 85, 88},
+        };
+        for (const auto &page : pages) {
+            const LatencyStats stats = BenchReport::latency([&]() {
+                reader.loadPage(Channel, 0, page.spo2Min, page.spo2Max, 0, 0, page.cursorMs,
+                                DatabaseReader::FirstPageCursor, PageSize);
+            }, quick ? 20 : 200);
+            QJsonObject metrics = stats.toJson();
+            metrics.insert("rows_returned", pageRows);
+            QJsonObject pageParams = params;
+            pageParams.insert("page_size", PageSize);
+            report.add("database", page.name, metrics, pageParams);
+        }
+        QObject::disconnect(connection);
+    }
+
+    // Farklı sınır kombinasyonları: hepsi aynı hazır sorguyu kullanır (yeniden planlama yok)
+    {
+        const int combos[][4] = {{85, 88, 0, 0}, {0, 0, 50, 120}, {85, 88, 50, 120}, {95, 0, 0, 60}};
+        int call = 0;
+        const LatencyStats stats = BenchReport::latency([&]() {
+            const int *c = combos[call++ % 4];
+            reader.loadFilteredData(Channel, 0, c[0], c[1], c[2], c[3]);
+        }, loadIterations * 4);
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("rows_returned_last", loadedRows);
+        QJsonObject filterParams = params;
+        filterParams.insert("filter", "4 bound combinations, round robin");
+        report.add("database", "load_filtered_varying", metrics, filterParams);
+    }
+
+    // Okuma yükü altında tek ölçüm kaydı: başka thread'deki okuyucu tabloyu durmadan tararken
+    // kayıt gecikmesi save_measurement ile aynı kalmalı (WAL: okuyucu yazarı beklemez)
+    {
+        QThread readThread;
+        auto *background = new DatabaseReader();
+        background->moveToThread(&readThread);
+        QObject::connect(&readThread, &QThread::finished, background, &QObject::deleteLater);
+
+        QAtomicInt running(0);
+        QAtomicInt stop(0);
+        QAtomicInt scans(0);
+        QObject::connect(&readThread, &QThread::started, background, [&, background]() {
+            background->initializeDatabase();
+            running.storeRelease(1);
+            while (!stop.loadAcquire()) {
+                background->loadAllData(DatabaseReader::ExportChannel, 0);
+                scans.fetchAndAddRelaxed(1);
+            }
+        });
+        readThread.start();
+        while (!running.loadAcquire())
+            QThread::msleep(1);
+
+        worker.setIngestPolicy(0, 1);
+        int counter = 0;
+        const LatencyStats stats = BenchReport::latency([&]() {
+            worker.saveMeasurement(1 + counter % Patients, 90 + counter % 10, 60 + counter % 40);
+            ++counter;
+        }, quick ? 20 : 200);
+
+        // Süren tarama bir sonraki satırda kesilir
+        stop.storeRelease(1);
+        background->cancelAll();
+        readThread.quit();
+        readThread.wait();
+
+        QJsonObject metrics = stats.toJson();
+        metrics.insert("concurrent_scans", scans.loadRelaxed());
+        report.add("database", "save_measurement_under_read_load", metrics, params);
+    }
+}
+
+} // namespace
+
+void runDatabaseBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    // DatabaseWorker "patients.db" dosyasını çalışma dizininde açar; gerçek veritabanına
+    // dokunmamak için geçici bir dizine geçilir
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        qCritical() << "Geçici dizin oluşturulamadı, veritabanı benchmark'ları atlandı";
+        return;
+    }
+    const QString previousDir = QDir::currentPath();
+    QDir::setCurrent(tempDir.path());
+
+    for (qint64 rows : options.dbRows)
+        runForSize(report, rows, options.quick);
+
+    QDir::setCurrent(previousDir);
+}
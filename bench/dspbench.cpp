@@ -0,0 +1,95 @@
+#include "benchreport.h"
+#include "dspfilter.h"
+#include <cmath>
+
+namespace {
+
+constexpr int BlockSize = 64;            // AcquisitionWorker::SampleBlock ile aynı
+constexpr int SamplesPerBed = 1 << 16;
+
+QVector<float> makePleth(int count, double phase)
+{
+    QVector<float> samples(count);
+    for (int i = 0; i < count; ++i)
+        samples[i] = static_cast<float>(128 + 80 * std::sin(i * 0.15 + phase) + 10 * std::sin(i * 2.5));
+    return samples;
+}
+
+PlethFilterConfig fullConfig()
+{
+    // Tüm aşamalar açık: DC giderme, 6 Hz LP, 10 Hz çentik, FIR + 2x decimation
+    PlethFilterConfig config;
+    config.dcRemoval = true;
+    config.notchHz = 10.0;
+    config.decimation = 2;
+    return config;
+}
+
+QJsonObject configJson(const PlethFilterConfig &config)
+{
+    QJsonObject params;
+    params.insert("sample_rate_hz", config.sampleRateHz);
+    params.insert("dc_removal", config.dcRemoval);
+    params.insert("low_pass_hz", config.lowPassHz);
+    params.insert("notch_hz", config.notchHz);
+    params.insert("decimation", config.decimation);
+    params.insert("block", BlockSize);
+    return params;
+}
+
+void runSingle(BenchReport &report, const QString &name, const PlethFilterConfig &config, qint64 minMs)
+{
+    const QVector<float> input = makePleth(SamplesPerBed, 0.0);
+    QVector<float> work(input.size());
+    PlethFilter filter(config);
+
+    const double ns = BenchReport::nsPerOp([&]() {
+        std::copy(input.cbegin(), input.cend(), work.begin());
+        for (int start = 0; start < work.size(); start += BlockSize)
+            filter.process(work.data() + start, qMin(BlockSize, static_cast<int>(work.size()) - start));
+    }, minMs);
+
+    QJsonObject metrics;
+    metrics.insert("samples_per_sec_per_core", SamplesPerBed / (ns / 1e9));
+    metrics.insert("ns_per_sample", ns / SamplesPerBed);
+    report.add("dsp", name, metrics, configJson(config));
+}
+
+void runBank(BenchReport &report, const PlethFilterConfig &config, qint64 minMs)
+{
+    constexpr int Lanes = PlethFilterBank::Lanes;
+    QVector<float> inputs[Lanes];
+    QVector<float> work[Lanes];
+    for (int lane = 0; lane < Lanes; ++lane) {
+        inputs[lane] = makePleth(SamplesPerBed, lane * 0.7);
+        work[lane].resize(SamplesPerBed);
+    }
+    PlethFilterBank bank(config);
+
+    const double ns = BenchReport::nsPerOp([&]() {
+        float *beds[Lanes];
+        for (int lane = 0; lane < Lanes; ++lane) {
+            std::copy(inputs[lane].cbegin(), inputs[lane].cend(), work[lane].begin());
+            beds[lane] = work[lane].data();
+        }
+        bank.process(beds, SamplesPerBed);
+    }, minMs);
+
+    QJsonObject metrics;
+    metrics.insert("bed_samples_per_sec_per_core", Lanes * SamplesPerBed / (ns / 1e9));
+    metrics.insert("ns_per_bed_sample", ns / (Lanes * SamplesPerBed));
+    QJsonObject params = configJson(config);
+    params.insert("beds", Lanes);
+    report.add("dsp", "pleth_bank4_full", metrics, params);
+}
+
+} // namespace
+
+void runDspBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    const qint64 minMs = options.quick ? 100 : 500;
+
+    runSingle(report, "pleth_default", PlethFilterConfig(), minMs);
+    runSingle(report, "pleth_full", fullConfig(), minMs);
+    runBank(report, fullConfig(), minMs);
+}
@@ -0,0 +1,84 @@
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include "benchreport.h"
+
+namespace {
+
+bool g_verbose = false;
+QtMessageHandler g_defaultHandler = nullptr;
+
+// Ölçüm sırasında üretim kodunun qDebug/qWarning çıktısı (ör. her bozuk pakette
+// yazılan uyarı) süreleri bozmasın diye yalnızca info ve üstü geçirilir
+void benchMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (!g_verbose && (type == QtDebugMsg || type == QtWarningMsg))
+        return;
+    g_defaultHandler(type, context, message);
+}
+
+QList<qint64> parseRowCounts(const QString &text)
+{
+    QList<qint64> rows;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const qint64 value = part.trimmed().toLongLong(&ok);
+        if (ok && value > 0)
+            rows.append(value);
+        else
+            qWarning() << "Geçersiz satır sayısı atlandı:" << part;
+    }
+    return rows;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // PDF ve QPainter ölçümleri için görüntü sunucusu gerekmez
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("spo2bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SpO2 Monitor sıcak yol benchmark'ları (JSON çıktı)");
+    parser.addHelpOption();
+    QCommandLineOption outputOption({"o", "output"}, "JSON çıktı dosyası (varsayılan: stdout)", "file");
+    QCommandLineOption groupOption({"g", "group"},
+                                   "Çalıştırılacak gruplar: acquisition,dsp,codec,storage,database,report", "groups",
+                                   "acquisition,dsp,codec,storage,database,report");
+    QCommandLineOption rowsOption("db-rows", "Veritabanı boyutları (virgülle ayrılmış)", "rows", "10000,1000000");
+    QCommandLineOption captureOption("capture", "Ayrıştırıcı benchmark'ı olarak oynatılacak kayıt oturumu", "dir");
+    QCommandLineOption quickOption("quick", "Kısa ölçüm süreleri (CI için)");
+    QCommandLineOption verboseOption("verbose", "Uygulama loglarını bastırma");
+    parser.addOptions({outputOption, groupOption, rowsOption, captureOption, quickOption, verboseOption});
+    parser.process(app);
+
+    g_verbose = parser.isSet(verboseOption);
+    g_defaultHandler = qInstallMessageHandler(benchMessageHandler);
+
+    BenchOptions options;
+    options.dbRows = parseRowCounts(parser.value(rowsOption));
+    options.quick = parser.isSet(quickOption);
+    options.captureDir = parser.value(captureOption);
+
+    const QStringList groups = parser.value(groupOption).split(',', Qt::SkipEmptyParts);
+
+    BenchReport report;
+    if (groups.contains("acquisition"))
+        runAcquisitionBenchmarks(report, options);
+    if (groups.contains("dsp"))
+        runDspBenchmarks(report, options);
+    if (groups.contains("codec"))
+        runCodecBenchmarks(report, options);
+    if (groups.contains("storage"))
+        runStorageBenchmarks(report, options);
+    if (groups.contains("database"))
+        runDatabaseBenchmarks(report, options);
+    if (groups.contains("report"))
+        runReportBenchmarks(report, options);
+
+    return report.write(parser.value(outputOption)) ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include "benchreport.h"
+#include "pdfexporter.h"
+#include "samplering.h"
+#include "waveformitem.h"
+#include "waveformpyramid.h"
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QTemporaryDir>
+#include <cmath>
+
+namespace {
+
+constexpr int DisplayPoints = 500;   // Reader::MAX_DISPLAY_POINTS
+const QSize TraceSize(800, 240);
+
+} // namespace
+
+void runReportBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    const qint64 minMs = options.quick ? 100 : 500;
+
+    // PDF raporu: 20 saniyelik (1000 örnek) waveform ile tam dosya yazımı
+    {
+        SampleRing<quint8> ring(50.0, 20);
+        qint64 ts = 0;
+        for (int i = 0; i < ring.capacity(); ++i)
+            ring.append(static_cast<quint8>(128 + 100 * std::sin(i * 0.12)), ts += 20);
+        const SampleSpan<quint8> waveform = ring.lastSeconds(20);
+
+        QTemporaryDir tempDir;
+        PdfExporter exporter;
+        int index = 0;
+        const LatencyStats stats = BenchReport::latency([&]() {
+            exporter.writeReport(tempDir.filePath(QString("bench_%1.pdf").arg(index++)),
+                                 "Benchmark Hasta", 97, 72, &waveform);
+        }, options.quick ? 3 : 20);
+
+        QJsonObject params;
+        params.insert("samples", waveform.size);
+        report.add("report", "pdf_export", stats.toJson(), params);
+    }
+
+    QVector<float> values(DisplayPoints);
+    for (int i = 0; i < DisplayPoints; ++i)
+        values[i] = static_cast<float>(128 + 100 * std::sin(i * 0.12));
+
+    QJsonObject traceParams;
+    traceParams.insert("width", TraceSize.width());
+    traceParams.insert("height", TraceSize.height());
+    traceParams.insert("points", DisplayPoints);
+
+    // Eski QML Canvas yolu: her karede ızgara + tüm izin yeniden rasterleştirilmesi
+    {
+        QImage image(TraceSize, QImage::Format_ARGB32_Premultiplied);
+        const double ns = BenchReport::nsPerOp([&]() {
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            painter.fillRect(image.rect(), QColor("#F5F5DC"));
+            painter.setPen(QPen(QColor("#DDDDDD"), 1));
+            for (int x = 0; x < TraceSize.width(); x += 40)
+                painter.drawLine(x, 0, x, TraceSize.height());
+            for (int y = 0; y < TraceSize.height(); y += 40)
+                painter.drawLine(0, y, TraceSize.width(), y);
+
+            QPainterPath path;
+            const double stepX = static_cast<double>(TraceSize.width()) / (DisplayPoints - 1);
+            for (int i = 0; i < DisplayPoints; ++i) {
+                const double y = TraceSize.height() - values[i] / 255.0 * TraceSize.height();
+                if (i == 0)
+                    path.moveTo(0, y);
+                else
+                    path.lineTo(i * stepX, y);
+            }
+            painter.setPen(QPen(QColor("#006400"), 2));
+            painter.drawPath(path);
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_frame", ns);
+        report.add("report", "trace_canvas_full_redraw", metrics, traceParams);
+    }
+
+    // WaveformTrace yolu: karede yalnızca yeni örneğin segmenti güncellenir
+    {
+        QSGGeometry geometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        SweepTraceBuilder builder;
+        builder.reset(&geometry, DisplayPoints, QSizeF(TraceSize), 4);
+        int index = 0;
+        const double ns = BenchReport::nsPerOp([&]() {
+            builder.append(&geometry, values.constData() + index, 1);
+            index = (index + 1) % DisplayPoints;
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_frame", ns);
+        report.add("report", "trace_sweep_incremental", metrics, traceParams);
+    }
+
+    // Geçmiş zarfı: 24 saatlik piramitten 10 s - 24 s pencereleri; maliyet sütun sayısına bağlı
+    {
+        const double sampleRate = 50.0;
+        const double historySeconds = options.quick ? 3600.0 : 86400.0;
+        WaveformPyramid<quint8> pyramid(sampleRate, historySeconds);
+
+        const qint64 samples = static_cast<qint64>(historySeconds * sampleRate);
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 i = 0; i < samples; ++i)
+            pyramid.append(static_cast<quint8>(128 + 100 * std::sin(i * 0.12)), i * 20);
+        const double appendNs = static_cast<double>(timer.nsecsElapsed()) / samples;
+
+        QJsonObject appendMetrics;
+        appendMetrics.insert("ns_per_sample", appendNs);
+        appendMetrics.insert("levels", pyramid.levelCount());
+        QJsonObject appendParams;
+        appendParams.insert("history_s", historySeconds);
+        appendParams.insert("sample_rate_hz", sampleRate);
+        report.add("report", "history_pyramid_append", appendMetrics, appendParams);
+
+        QSGGeometry geometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        EnvelopeTraceBuilder builder;
+        for (double span : {10.0, 60.0, 600.0, 3600.0, 21600.0, 86400.0}) {
+            if (span > historySeconds)
+                continue;
+            const double ns = BenchReport::nsPerOp([&]() {
+                builder.build(&geometry, pyramid, span, 0.0, QSizeF(TraceSize));
+            }, minMs);
+
+            QJsonObject metrics;
+            metrics.insert("ns_per_frame", ns);
+            metrics.insert("vertices", geometry.vertexCount());
+            QJsonObject params = traceParams;
+            params.remove("points");
+            params.insert("span_s", span);
+            report.add("report", "history_envelope_draw", metrics, params);
+        }
+    }
+}
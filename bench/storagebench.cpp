@@ -0,0 +1,181 @@
+#include "benchreport.h"
+#include "samplering.h"
+#include "waveformmodel.h"
+#include "waveformstatistics.h"
+#include "waveformstore.h"
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double SampleRateHz = 50.0;
+constexpr int RetentionSeconds = 20;
+
+} // namespace
+
+void runStorageBenchmarks(BenchReport &report, const BenchOptions &options)
+{
+    const qint64 minMs = options.quick ? 100 : 500;
+    QJsonObject params;
+    params.insert("sample_rate_hz", SampleRateHz);
+    params.insert("retention_s", RetentionSeconds);
+
+    // Dolu halkaya ekleme: her append bir örneği tahliye eder
+    {
+        SampleRing<quint8> ring(SampleRateHz, RetentionSeconds);
+        qint64 ts = 0;
+        for (int i = 0; i < ring.capacity(); ++i)
+            ring.append(static_cast<quint8>(i), ts += 20);
+
+        const double ns = BenchReport::nsPerOp([&]() {
+            ring.append(static_cast<quint8>(ts), ts += 20);
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_sample", ns);
+        metrics.insert("samples_per_sec", 1e9 / ns);
+        report.add("storage", "ring_append_evict", metrics, params);
+    }
+
+    // Anlık görüntü: son 20 saniye (PDF/ekran yolu); span + içeriği bir kez okuma
+    {
+        SampleRing<quint8> ring(SampleRateHz, RetentionSeconds);
+        qint64 ts = 0;
+        for (int i = 0; i < 3 * ring.capacity(); ++i)
+            ring.append(static_cast<quint8>(i), ts += 20);
+
+        volatile quint32 sink = 0;
+        const double spanNs = BenchReport::nsPerOp([&]() {
+            sink = sink + static_cast<quint32>(ring.lastSeconds(RetentionSeconds).size);
+        }, minMs);
+        const double readNs = BenchReport::nsPerOp([&]() {
+            quint32 sum = 0;
+            for (quint8 v : ring.lastSeconds(RetentionSeconds))
+                sum += v;
+            sink = sink + sum;
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_snapshot", spanNs);
+        metrics.insert("ns_per_snapshot_read", readNs);
+        metrics.insert("samples", ring.size());
+        report.add("storage", "ring_snapshot", metrics, params);
+    }
+
+    // Ekran modeli: her karede ~1 yeni örnek, dolu modelde remove+insert
+    {
+        SampleRing<quint8> ring(SampleRateHz, RetentionSeconds);
+        WaveformModel model(200, SampleRateHz);
+        qint64 ts = 0;
+        qint64 cursor = 0;
+        const double ns = BenchReport::nsPerOp([&]() {
+            ring.append(static_cast<quint8>(ts), ts += 20);
+            model.appendSamples(ring.since(cursor));
+            cursor = ring.totalWritten();
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_frame", ns);
+        QJsonObject modelParams = params;
+        modelParams.insert("model_capacity", 200);
+        report.add("storage", "waveform_model_append", metrics, modelParams);
+    }
+
+    // Kayan pencere istatistikleri: artımlı (örnek başına) vs her karede pencereyi tarama
+    {
+        const int window = static_cast<int>(5 * SampleRateHz);
+        StreamingStats stats;
+        stats.configure(window);
+        quint32 state = 1;
+        auto nextValue = [&]() {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<float>(state >> 24);
+        };
+
+        volatile double sink = 0.0;
+        const double incrementalNs = BenchReport::nsPerOp([&]() {
+            stats.add(nextValue());
+            sink = sink + stats.peakToPeak();
+        }, minMs);
+
+        SampleRing<quint8> ring(SampleRateHz, RetentionSeconds);
+        qint64 ts = 0;
+        const double rescanNs = BenchReport::nsPerOp([&]() {
+            ring.append(static_cast<quint8>(nextValue()), ts += 20);
+            const SampleSpan<quint8> span = ring.lastSeconds(5);
+            float lo = 255.0f, hi = 0.0f;
+            double sum = 0.0, sumSq = 0.0;
+            for (quint8 v : span) {
+                lo = std::min<float>(lo, v);
+                hi = std::max<float>(hi, v);
+                sum += v;
+                sumSq += double(v) * v;
+            }
+            sink = sink + (hi - lo) + std::sqrt(sumSq - sum * sum / qMax(1, span.size));
+        }, minMs);
+
+        QJsonObject metrics;
+        metrics.insert("ns_per_sample_incremental", incrementalNs);
+        metrics.insert("ns_per_sample_rescan", rescanNs);
+        metrics.insert("speedup", rescanNs / incrementalNs);
+        QJsonObject statsParams = params;
+        statsParams.insert("window_samples", window);
+        report.add("storage", "waveform_statistics", metrics, statsParams);
+    }
+
+    // Uzun süreli arşiv: çok yataklı parça yazımı ve zaman aralığı okuma
+    {
+        QTemporaryDir dir;
+        WaveformStore store(dir.path());
+        const int beds = 8;
+        const double chunkSeconds = 10.0;
+        const int chunkSamples = static_cast<int>(chunkSeconds * SampleRateHz);
+        const int hours = options.quick ? 1 : 6;
+        const int chunksPerBed = static_cast<int>(hours * 3600 / chunkSeconds);
+        const qint64 t0 = 1700000000000LL;
+
+        QByteArray chunk(chunkSamples, Qt::Uninitialized);
+        QElapsedTimer timer;
+        timer.start();
+        for (int c = 0; c < chunksPerBed; ++c) {
+            for (int i = 0; i < chunkSamples; ++i) {
+                const double phase = (c * chunkSamples + i) * 2.0 * 3.14159265358979 * 1.2 / SampleRateHz;
+                chunk[i] = static_cast<char>(128 + 90 * std::sin(phase) + (i % 3));
+            }
+            for (int bed = 1; bed <= beds; ++bed)
+                store.appendChunk(bed, t0 + static_cast<qint64>(c * chunkSeconds * 1000), SampleRateHz, chunk);
+        }
+        const double seconds = timer.nsecsElapsed() / 1e9;
+
+        QJsonObject ingestMetrics;
+        ingestMetrics.insert("chunks_per_sec", store.chunksWritten() / seconds);
+        ingestMetrics.insert("bed_realtime_factor", (beds * hours * 3600.0) / seconds);
+        ingestMetrics.insert("compression_ratio", static_cast<double>(store.samplesWritten()) / store.bytesWritten());
+        QJsonObject ingestParams = params;
+        ingestParams.insert("beds", beds);
+        ingestParams.insert("chunk_s", chunkSeconds);
+        ingestParams.insert("hours_per_bed", hours);
+        report.add("storage", "waveform_store_ingest", ingestMetrics, ingestParams);
+
+        // Aralık okuma: yalnızca kesişen parçalar çözülür, maliyet aralıkla orantılı
+        for (double span : {10.0, 60.0, 600.0, 3600.0}) {
+            if (span > hours * 3600)
+                continue;
+            const qint64 from = t0 + static_cast<qint64>((hours * 3600 - span) * 500); // arşivin ortası
+            qint64 samples = 0;
+            const LatencyStats stats = BenchReport::latency([&]() {
+                const QVector<WaveformRange> ranges = store.readRange(3, from, from + static_cast<qint64>(span * 1000));
+                samples = 0;
+                for (const WaveformRange &range : ranges)
+                    samples += range.samples.size();
+            }, options.quick ? 20 : 200);
+
+            QJsonObject rangeParams = params;
+            rangeParams.insert("span_s", span);
+            rangeParams.insert("archive_h", hours);
+            rangeParams.insert("samples", samples);
+            report.add("storage", "waveform_store_range", stats.toJson(), rangeParams);
+        }
+    }
+}
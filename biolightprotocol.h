@@ -0,0 +1,164 @@
+#ifndef BIOLIGHTPROTOCOL_H
+#define BIOLIGHTPROTOCOL_H
+
+#include <QtGlobal>
+#include <array>
+#include "packetframer.h"
+
+// Biolight SpO2 modülü paket tanımları ve derleme zamanında üretilen çözücü.
+//
+// Her paket kodu tek bir tanım yapısıdır: kod, en küçük LEN ve alan listesi
+// (paket içi konum, genişlik, bit maskesi, geçersiz değer). Tanımlar Packets
+// listesinden 256 girişli bir fonksiyon işaretçisi tablosuna dönüştürülür;
+// decode() tek bir dizi erişimi + alan başına sabit konumlu okumadır, string,
+// QVariant ya da heap ayırması yoktur. Yeni bir kod için yalnızca yeni bir tanım
+// yazıp Packets listesine eklemek yeterlidir.
+//
+// Konumlar paketin başından sayılır (0: 0xAA, 1: 0x55, 2: LEN, 3: CODE).
+namespace Biolight {
+
+enum Field : quint8 {
+    Pleth,           // ham pletismografi örneği (0-255)
+    Spo2,            // %
+    PulseRate,       // bpm
+    PerfusionIndex,  // 0.01 % birimi
+    ProbeOff,        // 1: prob parmakta değil
+    SearchingPulse,  // 1: nabız aranıyor
+    SensorFault,     // 1: sensör/LED hatası
+    StatusFlags,     // ham durum baytı
+    FieldCount
+};
+
+constexpr qint32 NoSentinel = -1;
+
+struct FieldSpec {
+    Field field;
+    quint8 offset;               // paket içindeki ilk bayt
+    quint8 width = 1;            // 1 ya da 2 bayt (big endian)
+    quint16 mask = 0xFFFF;       // bit alanları için
+    qint32 sentinel = NoSentinel; // maskelenmiş ham değer buna eşitse "geçersiz" (-1)
+};
+
+// Çözülmüş paket: yalnızca present içindeki alanlar pakette vardı.
+// Değer -1 ise alan pakette var ama cihaz geçersiz (sentinel) bildirdi.
+struct Decoded {
+    quint8 code = 0;
+    quint16 present = 0;
+    qint32 values[FieldCount] = {};
+
+    bool has(Field field) const { return present & (1u << field); }
+    qint32 value(Field field, qint32 fallback = -1) const { return has(field) ? values[field] : fallback; }
+};
+static_assert(FieldCount <= 16, "present maskesi 16 alan taşır");
+
+// --- Paket tanımları ---
+// Yalnızca modül dokümanında yerleşimi belli olan ve sahada doğrulanan kodlar listelenir.
+// Perfüzyon, durum ve prob alanları için henüz belgelenmiş bir paket yok; bu kodlar
+// bilinmeyen paket sayılır, Reader'ın PI/prob özellikleri "geçersiz" kalır.
+
+struct ParameterPacket {
+    static constexpr quint8 code = 21;
+    static constexpr quint8 minLength = 10;
+    static constexpr FieldSpec fields[] = {
+        {Pleth, 5, 1, 0xFFFF, 127},
+        {Spo2, 7, 1, 0xFFFF, 127},
+        {PulseRate, 8, 2, 0xFFFF, 255},
+    };
+};
+
+template <typename... Specs>
+struct PacketList {};
+
+using Packets = PacketList<ParameterPacket>;
+
+// --- Çözücü üretimi ---
+
+namespace detail {
+
+constexpr int maskShift(quint16 mask)
+{
+    int shift = 0;
+    while (shift < 16 && !(mask & (1u << shift)))
+        ++shift;
+    return shift;
+}
+
+template <typename Spec>
+constexpr bool fieldsFit()
+{
+    // Tüm alanlar minLength ile garanti edilen çerçevenin içinde olmalı
+    for (const FieldSpec &f : Spec::fields) {
+        if (f.width != 1 && f.width != 2)
+            return false;
+        if (f.offset < 4 || f.offset + f.width > 3 + Spec::minLength)
+            return false;
+    }
+    return true;
+}
+
+template <typename Spec>
+bool decodePacket(const PacketView &packet, Decoded &out)
+{
+    static_assert(fieldsFit<Spec>(), "Alan konumu minLength dışında");
+
+    if (packet.len() < Spec::minLength)
+        return false;
+
+    out.code = Spec::code;
+    out.present = 0;
+    for (const FieldSpec &f : Spec::fields) {
+        quint32 raw = packet.at(f.offset);
+        if (f.width == 2)
+            raw = (raw << 8) | packet.at(f.offset + 1);
+        raw = (raw & f.mask) >> maskShift(f.mask);
+
+        out.values[f.field] = (f.sentinel != NoSentinel && raw == static_cast<quint32>(f.sentinel))
+                                  ? -1 : static_cast<qint32>(raw);
+        out.present |= static_cast<quint16>(1u << f.field);
+    }
+    return true;
+}
+
+using DecodeFn = bool (*)(const PacketView &, Decoded &);
+using DispatchTable = std::array<DecodeFn, 256>;
+
+template <typename... Specs>
+constexpr bool codesUnique(PacketList<Specs...>)
+{
+    const quint8 codes[] = {Specs::code...};
+    for (size_t i = 0; i < sizeof...(Specs); ++i)
+        for (size_t j = i + 1; j < sizeof...(Specs); ++j)
+            if (codes[i] == codes[j])
+                return false;
+    return true;
+}
+
+template <typename... Specs>
+constexpr DispatchTable makeDispatchTable(PacketList<Specs...>)
+{
+    DispatchTable table{};
+    ((table[Specs::code] = &decodePacket<Specs>), ...);
+    return table;
+}
+
+} // namespace detail
+
+static_assert(detail::codesUnique(Packets{}), "Aynı paket kodu iki kez tanımlanmış");
+
+inline constexpr detail::DispatchTable Dispatch = detail::makeDispatchTable(Packets{});
+
+// Bilinmeyen kod ya da kısa paket için false döner
+inline bool decode(const PacketView &packet, Decoded &out)
+{
+    const detail::DecodeFn fn = Dispatch[packet.code()];
+    return fn && fn(packet, out);
+}
+
+inline bool isKnownCode(quint8 code)
+{
+    return Dispatch[code] != nullptr;
+}
+
+} // namespace Biolight
+
+#endif // BIOLIGHTPROTOCOL_H
@@ -0,0 +1,10 @@
+# Sanal Biolight SpO2 modülü (Linux pseudo-terminal üzerinde yük üreteci)
+TEMPLATE = app
+TARGET = biolightsim
+
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+SOURCES += main.cpp
+
+!linux: error("biolightsim yalnızca Linux pty üzerinde çalışır")
@@ -0,0 +1,438 @@
+// Sanal Biolight SpO2 modülü.
+// Bir pseudo-terminal açar ve Reader'ın beklediği AA55 LEN CODE ... CHECKSUM
+// paketlerini (code 21: pleth, SpO2, PR) istenen hızda üretir. Gürültü, bozuk checksum ve yarım paket enjekte
+// edilebilir; BF5FFF başlatma komutuna ve code 0x06 ayar paketine yanıt verir.
+//
+// Kullanım: biolightsim --rate 5000 --noise 0.01 --corrupt 0.01 --partial 0.01 --link /tmp/biolight0
+// Uygulama tarafında devices.ini içinde port=/tmp/biolight0 (veya yazdırılan /dev/pts/N) verilir.
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t g_running = 1;
+
+void onSignal(int)
+{
+    g_running = 0;
+}
+
+struct Options {
+    double rate = 50.0;          // paket/s
+    double noise = 0.0;          // paket başına rastgele çöp bayt patlaması olasılığı
+    double corrupt = 0.0;        // paket başına bozuk checksum olasılığı
+    double partial = 0.0;        // paket başına yarıda kesilmiş paket olasılığı
+    double duration = 0.0;       // saniye, 0 = sınırsız
+    int spo2 = 98;
+    int pr = 72;
+    bool autostart = false;      // BF5FFF beklemeden yayına başla
+    std::string link;            // slave pty için sembolik bağlantı
+    unsigned seed = 1;
+};
+
+struct Stats {
+    uint64_t frames = 0;
+    uint64_t corrupted = 0;
+    uint64_t partial = 0;
+    uint64_t noiseBytes = 0;
+    uint64_t droppedBytes = 0;   // pty tamponu dolu (okuyucu yetişemiyor)
+    uint64_t bytes = 0;
+};
+
+double monotonicSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void usage(const char *argv0)
+{
+    std::fprintf(stderr,
+                 "Kullanım: %s [seçenekler]\n"
+                 "  --rate HZ        paket hızı (varsayılan 50)\n"
+                 "  --noise P        paket başına çöp bayt olasılığı (0..1)\n"
+                 "  --corrupt P      paket başına bozuk checksum olasılığı (0..1)\n"
+                 "  --partial P      paket başına yarım paket olasılığı (0..1)\n"
+                 "  --duration S     S saniye sonra çık (0 = sınırsız)\n"
+                 "  --spo2 N         SpO2 değeri (127 = geçersiz)\n"
+                 "  --pr N           nabız değeri (255 = geçersiz)\n"
+                 "  --autostart      BF5FFF komutunu beklemeden yayına başla\n"
+                 "  --link PATH      slave pty için sembolik bağlantı oluştur\n"
+                 "  --seed N         rastgele sayı tohumu\n",
+                 argv0);
+}
+
+bool parseOptions(int argc, char **argv, Options &options)
+{
+    static const option longOptions[] = {
+        {"rate", required_argument, nullptr, 'r'},
+        {"noise", required_argument, nullptr, 'n'},
+        {"corrupt", required_argument, nullptr, 'c'},
+        {"partial", required_argument, nullptr, 'p'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"spo2", required_argument, nullptr, 's'},
+        {"pr", required_argument, nullptr, 'P'},
+        {"autostart", no_argument, nullptr, 'a'},
+        {"link", required_argument, nullptr, 'l'},
+        {"seed", required_argument, nullptr, 'S'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", longOptions, nullptr)) != -1) {
+        switch (opt) {
+        case 'r': options.rate = std::atof(optarg); break;
+        case 'n': options.noise = std::atof(optarg); break;
+        case 'c': options.corrupt = std::atof(optarg); break;
+        case 'p': options.partial = std::atof(optarg); break;
+        case 'd': options.duration = std::atof(optarg); break;
+        case 's': options.spo2 = std::atoi(optarg); break;
+        case 'P': options.pr = std::atoi(optarg); break;
+        case 'a': options.autostart = true; break;
+        case 'l': options.link = optarg; break;
+        case 'S': options.seed = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10)); break;
+        default:
+            usage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.rate <= 0.0) {
+        std::fprintf(stderr, "Geçersiz --rate\n");
+        return false;
+    }
+    return true;
+}
+
+// AA55 LEN CODE payload... CHECKSUM  (checksum = LEN + CODE + payload, 8 bit)
+void appendFrame(std::vector<uint8_t> &out, uint8_t code, const uint8_t *payload, int payloadSize,
+                 bool corrupt)
+{
+    const uint8_t len = static_cast<uint8_t>(payloadSize + 1);
+    uint8_t sum = static_cast<uint8_t>(len + code);
+
+    out.push_back(0xAA);
+    out.push_back(0x55);
+    out.push_back(len);
+    out.push_back(code);
+    for (int i = 0; i < payloadSize; ++i) {
+        out.push_back(payload[i]);
+        sum = static_cast<uint8_t>(sum + payload[i]);
+    }
+    out.push_back(corrupt ? static_cast<uint8_t>(~sum) : sum);
+}
+
+// Sentetik pleth dalgası: sistolik tepe + dikrotik çentik, 0..255
+uint8_t plethSample(double phase)
+{
+    const double systolic = std::exp(-std::pow((phase - 0.20) / 0.08, 2.0));
+    const double dicrotic = 0.35 * std::exp(-std::pow((phase - 0.55) / 0.10, 2.0));
+    int value = static_cast<int>(40.0 + 180.0 * (systolic + dicrotic) / 1.05);
+    value = value < 0 ? 0 : (value > 255 ? 255 : value);
+    if (value == 127) value = 128; // 127 geçersiz pleth işaretidir
+    return static_cast<uint8_t>(value);
+}
+
+class VirtualDevice
+{
+public:
+    VirtualDevice(const Options &options)
+        : m_options(options)
+        , m_random(options.seed)
+        , m_streaming(options.autostart)
+    {
+    }
+
+    ~VirtualDevice()
+    {
+        if (!m_options.link.empty())
+            unlink(m_options.link.c_str());
+        if (m_slave >= 0) close(m_slave);
+        if (m_master >= 0) close(m_master);
+    }
+
+    bool open()
+    {
+        m_master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0) {
+            std::perror("posix_openpt");
+            return false;
+        }
+
+        const char *slaveName = ptsname(m_master);
+        if (!slaveName) {
+            std::perror("ptsname");
+            return false;
+        }
+        m_slaveName = slaveName;
+
+        // Slave ucunu açık tutarak ham moda al; okuyucu bağlanıp ayrılsa da hat kapanmaz
+        m_slave = ::open(slaveName, O_RDWR | O_NOCTTY);
+        if (m_slave < 0) {
+            std::perror("open slave");
+            return false;
+        }
+        termios tio;
+        if (tcgetattr(m_slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(m_slave, TCSANOW, &tio);
+        }
+
+        if (!m_options.link.empty()) {
+            unlink(m_options.link.c_str());
+            if (symlink(slaveName, m_options.link.c_str()) != 0) {
+                std::perror("symlink");
+                return false;
+            }
+        }
+
+        std::printf("biolightsim: %s%s%s, %.0f paket/s, %s\n", slaveName,
+                    m_options.link.empty() ? "" : " -> ", m_options.link.c_str(),
+                    m_options.rate, m_streaming ? "yayın açık" : "BF5FFF bekleniyor");
+        std::fflush(stdout);
+        return true;
+    }
+
+    void run()
+    {
+        const double start = monotonicSeconds();
+        double lastReport = start;
+        double streamStart = start;
+        uint64_t framesDue = 0;
+
+        while (g_running) {
+            const double now = monotonicSeconds();
+            if (m_options.duration > 0.0 && now - start >= m_options.duration)
+                break;
+
+            // Komutları oku (en fazla 1 ms bekle)
+            pollCommands(1);
+
+            if (m_streaming) {
+                if (!m_wasStreaming) {
+                    streamStart = monotonicSeconds();
+                    framesDue = 0;
+                    m_wasStreaming = true;
+                }
+                // Geçen süreye göre borçlu olunan paketleri toplu yaz
+                const uint64_t target = static_cast<uint64_t>((monotonicSeconds() - streamStart) * m_options.rate);
+                m_out.clear();
+                while (framesDue < target) {
+                    buildFrame();
+                    ++framesDue;
+                }
+                writeOut();
+            }
+
+            if (now - lastReport >= 5.0) {
+                report(now - start);
+                lastReport = now;
+            }
+        }
+
+        report(monotonicSeconds() - start);
+    }
+
+private:
+    bool chance(double probability)
+    {
+        return probability > 0.0 && m_uniform(m_random) < probability;
+    }
+
+    void buildFrame()
+    {
+        // Gürültü: rastgele çöp baytlar (0xAA dahil olabilir -> sahte senkron)
+        if (chance(m_options.noise)) {
+            const int count = 1 + static_cast<int>(m_random() % 16);
+            for (int i = 0; i < count; ++i)
+                m_out.push_back(static_cast<uint8_t>(m_random()));
+            m_stats.noiseBytes += count;
+        }
+
+        const double beatsPerSecond = (m_options.pr > 0 && m_options.pr != 255) ? m_options.pr / 60.0 : 1.0;
+        m_phase += beatsPerSecond / m_options.rate;
+        m_phase -= std::floor(m_phase);
+
+        // Payload ofsetleri Reader ile aynı: [4] durum, [5] pleth, [6] bar, [7] SpO2, [8..9] PR
+        uint8_t payload[9] = {};
+        payload[0] = 0x00;
+        payload[1] = plethSample(m_phase);
+        payload[2] = 0x00;
+        payload[3] = static_cast<uint8_t>(m_options.spo2);
+        payload[4] = static_cast<uint8_t>((m_options.pr >> 8) & 0xFF);
+        payload[5] = static_cast<uint8_t>(m_options.pr & 0xFF);
+
+        const bool corrupt = chance(m_options.corrupt);
+        const size_t frameStart = m_out.size();
+        appendFrame(m_out, 21, payload, static_cast<int>(sizeof(payload)), corrupt);
+        ++m_stats.frames;
+        if (corrupt) ++m_stats.corrupted;
+
+        // Yarım paket: sonunu kes, ardından gelen paket yeniden senkron gerektirir
+        if (chance(m_options.partial)) {
+            const size_t frameSize = m_out.size() - frameStart;
+            const size_t keep = 1 + m_random() % (frameSize - 1);
+            m_out.resize(frameStart + keep);
+            ++m_stats.partial;
+        }
+    }
+
+    void writeOut()
+    {
+        size_t offset = 0;
+        while (offset < m_out.size()) {
+            const ssize_t n = write(m_master, m_out.data() + offset, m_out.size() - offset);
+            if (n > 0) {
+                offset += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+                continue;
+            // EAGAIN: okuyucu yetişemiyor; gerçek cihaz gibi taşan veriyi kaybet
+            m_stats.droppedBytes += m_out.size() - offset;
+            break;
+        }
+        m_stats.bytes += offset;
+    }
+
+    void pollCommands(int timeoutMs)
+    {
+        pollfd pfd = {m_master, POLLIN, 0};
+        if (poll(&pfd, 1, timeoutMs) <= 0 || !(pfd.revents & POLLIN))
+            return;
+
+        uint8_t buffer[256];
+        const ssize_t n = read(m_master, buffer, sizeof(buffer));
+        if (n <= 0)
+            return;
+
+        m_in.insert(m_in.end(), buffer, buffer + n);
+        parseCommands();
+    }
+
+    void parseCommands()
+    {
+        size_t i = 0;
+        while (i < m_in.size()) {
+            // Başlatma komutu: BF 5F FF
+            if (m_in[i] == 0xBF) {
+                if (m_in.size() - i < 3) break;
+                if (m_in[i + 1] == 0x5F && m_in[i + 2] == 0xFF) {
+                    if (!m_streaming)
+                        std::printf("biolightsim: BF5FFF alındı, yayın başlıyor\n");
+                    m_streaming = true;
+                    i += 3;
+                    continue;
+                }
+            }
+            // Ayar paketi: AA 55 02 06 DATA CHECKSUM
+            if (m_in[i] == 0xAA) {
+                if (m_in.size() - i < 4) break;
+                if (m_in[i + 1] == 0x55) {
+                    const uint8_t len = m_in[i + 2];
+                    const size_t total = 2 + 1 + len + 1;
+                    if (m_in.size() - i < total) break;
+                    handlePacket(&m_in[i], len);
+                    i += total;
+                    continue;
+                }
+            }
+            ++i; // tanınmayan bayt
+        }
+        m_in.erase(m_in.begin(), m_in.begin() + static_cast<long>(i));
+        std::fflush(stdout);
+    }
+
+    void handlePacket(const uint8_t *packet, uint8_t len)
+    {
+        uint8_t sum = len;
+        for (int i = 0; i < len; ++i)
+            sum = static_cast<uint8_t>(sum + packet[3 + i]);
+        if (sum != packet[3 + len]) {
+            std::printf("biolightsim: checksum hatalı komut paketi atıldı\n");
+            return;
+        }
+
+        const uint8_t code = packet[3];
+        if (code == 0x06 && len >= 2) {
+            const uint8_t data = packet[4];
+            const char *response = "bilinmiyor";
+            switch (data) {
+            case 0x92: response = "4 s"; break;
+            case 0xB2: response = "8 s"; break;
+            case 0xD2: response = "16 s"; break;
+            default: break;
+            }
+            std::printf("biolightsim: ayar paketi 0x%02X (frekans bitleri %d, response time %s)\n",
+                        data, data & 0x03, response);
+        } else {
+            std::printf("biolightsim: code 0x%02X komutu yok sayıldı\n", code);
+        }
+    }
+
+    void report(double elapsed)
+    {
+        std::printf("biolightsim: %.1f s, %llu paket (%.0f/s), %llu bayt, bozuk %llu, yarım %llu, "
+                    "gürültü %llu bayt, düşen %llu bayt\n",
+                    elapsed,
+                    static_cast<unsigned long long>(m_stats.frames),
+                    elapsed > 0.0 ? m_stats.frames / elapsed : 0.0,
+                    static_cast<unsigned long long>(m_stats.bytes),
+                    static_cast<unsigned long long>(m_stats.corrupted),
+                    static_cast<unsigned long long>(m_stats.partial),
+                    static_cast<unsigned long long>(m_stats.noiseBytes),
+                    static_cast<unsigned long long>(m_stats.droppedBytes));
+        std::fflush(stdout);
+    }
+
+    Options m_options;
+    std::mt19937 m_random;
+    std::uniform_real_distribution<double> m_uniform{0.0, 1.0};
+    int m_master = -1;
+    int m_slave = -1;
+    std::string m_slaveName;
+    bool m_streaming;
+    bool m_wasStreaming = false;
+    double m_phase = 0.0;
+    std::vector<uint8_t> m_out;
+    std::vector<uint8_t> m_in;
+    Stats m_stats;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    VirtualDevice device(options);
+    if (!device.open())
+        return 1;
+
+    device.run();
+    return 0;
+}
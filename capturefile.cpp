@@ -0,0 +1,308 @@
+#include "capturefile.h"
+#include <QDateTime>
+#include <QDir>
+#include <QDebug>
+#include <cstring>
+
+QString Capture::segmentFileName(const QString &directory, quint32 index)
+{
+    return QDir(directory).filePath(QStringLiteral("segment_%1.bcap").arg(index, 6, 10, QLatin1Char('0')));
+}
+
+// --- CaptureWriter ---
+
+CaptureWriter::CaptureWriter(qint64 segmentSize)
+    : m_segmentSize(qMax<qint64>(segmentSize, 64 * 1024))
+    , m_prepareOffset(static_cast<qint64>(m_segmentSize * PrepareThreshold))
+{
+    m_helper.setMaxThreadCount(1);
+    m_helper.setExpiryTimeout(-1); // okuma yolunda thread oluşturulmaz
+    m_helper.setThreadPriority(QThread::LowPriority);
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    close();
+}
+
+bool CaptureWriter::open(const QString &directory)
+{
+    close();
+
+    QDir dir(directory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qWarning() << "CaptureWriter: dizin oluşturulamadı:" << directory;
+        return false;
+    }
+    // Aynı dizindeki eski oturumun segmentleri yeni kayıtla karışmasın
+    for (const QString &old : dir.entryList({"segment_*.bcap"}, QDir::Files))
+        dir.remove(old);
+
+    m_directory = directory;
+    m_startedAtMs = QDateTime::currentMSecsSinceEpoch();
+    m_bytesWritten = 0;
+    m_recordCount = 0;
+    m_stalledSwitches = 0;
+    m_clock.start();
+
+    m_current = openSegment(0);
+    if (!m_current.base) {
+        m_directory.clear();
+        return false;
+    }
+    m_offset = sizeof(Capture::SegmentHeader);
+    qDebug() << "CaptureWriter: ham veri kaydı başladı:" << directory;
+    return true;
+}
+
+void CaptureWriter::close()
+{
+    // Yardımcıdaki hazırlama/kapatma işleri bitmeden segmentlere dokunulmaz
+    m_helper.waitForDone();
+
+    // Önceden açılmış ama hiç yazılmamış segment silinir
+    if (m_standbyReady.exchange(false, std::memory_order_acquire) && m_standby.file) {
+        const QString fileName = m_standby.file->fileName();
+        closeSegment(m_standby, sizeof(Capture::SegmentHeader));
+        QFile::remove(fileName);
+    }
+    m_standby = Segment();
+    m_standbyRequested = false;
+
+    if (!isOpen())
+        return;
+
+    const quint32 segments = m_current.index + 1;
+    closeSegment(m_current, m_offset);
+    m_current = Segment();
+    qDebug() << "CaptureWriter: kayıt kapatıldı:" << m_directory
+             << "(" << m_recordCount << "kayıt," << m_bytesWritten << "bayt,"
+             << segments << "segment," << m_stalledSwitches << "bekleyen geçiş)";
+}
+
+bool CaptureWriter::append(const char *data, int size)
+{
+    if (!isOpen() || size <= 0)
+        return false;
+
+    const qint64 needed = static_cast<qint64>(sizeof(Capture::RecordHeader)) + size;
+    // Segment sonunda en az bir boş kayıt başlığı (sonlandırıcı) yeri bırakılır
+    if (m_offset + needed + static_cast<qint64>(sizeof(Capture::RecordHeader)) > m_segmentSize) {
+        if (needed + static_cast<qint64>(sizeof(Capture::SegmentHeader) + sizeof(Capture::RecordHeader)) > m_segmentSize) {
+            qWarning() << "CaptureWriter: kayıt segmentten büyük, atlandı:" << size << "bayt";
+            return false;
+        }
+        if (!switchSegment())
+            return false;
+    }
+
+    Capture::RecordHeader header;
+    header.timestampNs = m_clock.nsecsElapsed();
+    header.length = static_cast<quint32>(size);
+    header.reserved = 0;
+
+    std::memcpy(m_current.base + m_offset, &header, sizeof(header));
+    std::memcpy(m_current.base + m_offset + sizeof(header), data, static_cast<size_t>(size));
+    m_offset += needed;
+
+    if (!m_standbyRequested && m_offset >= m_prepareOffset)
+        requestNextSegment();
+
+    m_bytesWritten += static_cast<quint64>(size);
+    ++m_recordCount;
+    return true;
+}
+
+void CaptureWriter::requestNextSegment()
+{
+    m_standbyRequested = true;
+    const quint32 index = m_current.index + 1;
+    m_helper.start([this, index]() {
+        m_standby = openSegment(index);
+        m_standbyReady.store(true, std::memory_order_release);
+    });
+}
+
+bool CaptureWriter::switchSegment()
+{
+    if (!m_standbyRequested)
+        requestNextSegment();
+    if (!m_standbyReady.load(std::memory_order_acquire)) {
+        // Disk, segmentin son %25'i dolana kadar dosyayı hazırlayamadı: beklemekten başka yol yok
+        ++m_stalledSwitches;
+        qWarning() << "CaptureWriter: sıradaki segment hazır değil, bekleniyor";
+        m_helper.waitForDone();
+    }
+
+    const Segment full = m_current;
+    const qint64 used = m_offset;
+    m_current = m_standby;
+    m_standby = Segment();
+    m_standbyReady.store(false, std::memory_order_relaxed);
+    m_standbyRequested = false;
+    m_offset = sizeof(Capture::SegmentHeader);
+
+    // Dolan segmentin unmap/ftruncate/close'u yardımcıda
+    m_helper.start([full, used]() { closeSegment(full, used); });
+
+    // Açılamadıysa (openSegment uyarı loglar) kayıt durur: isOpen() false
+    return isOpen();
+}
+
+CaptureWriter::Segment CaptureWriter::openSegment(quint32 index) const
+{
+    Segment segment;
+    auto *file = new QFile(Capture::segmentFileName(m_directory, index));
+    if (!file->open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qWarning() << "CaptureWriter: segment açılamadı:" << file->fileName() << file->errorString();
+        delete file;
+        return segment;
+    }
+    // Seyrek dosya: sıfırla doldurulmuş alan disk üzerinde yer kaplamaz
+    if (!file->resize(m_segmentSize)) {
+        qWarning() << "CaptureWriter: segment boyutlandırılamadı:" << file->errorString();
+        delete file;
+        return segment;
+    }
+    uchar *base = file->map(0, m_segmentSize);
+    if (!base) {
+        qWarning() << "CaptureWriter: segment belleğe eşlenemedi:" << file->errorString();
+        delete file;
+        return segment;
+    }
+
+    Capture::SegmentHeader header;
+    std::memcpy(header.magic, Capture::Magic, sizeof(header.magic));
+    header.startedAtMs = m_startedAtMs;
+    header.segmentIndex = index;
+    header.headerSize = sizeof(Capture::SegmentHeader);
+    header.reserved = 0;
+    std::memcpy(base, &header, sizeof(header));
+
+    segment.file = file;
+    segment.base = base;
+    segment.index = index;
+    return segment;
+}
+
+void CaptureWriter::closeSegment(const Segment &segment, qint64 usedBytes)
+{
+    if (!segment.file)
+        return;
+
+    if (segment.base)
+        segment.file->unmap(segment.base);
+    // Kullanılmayan kuyruk kesilir; sonlandırıcı kayıt başlığı korunur
+    segment.file->resize(usedBytes + static_cast<qint64>(sizeof(Capture::RecordHeader)));
+    segment.file->close();
+    delete segment.file;
+}
+
+// --- CaptureReader ---
+
+CaptureReader::~CaptureReader()
+{
+    close();
+}
+
+bool CaptureReader::open(const QString &directory)
+{
+    close();
+
+    QDir dir(directory);
+    const QStringList names = dir.entryList({"segment_*.bcap"}, QDir::Files, QDir::Name);
+    for (const QString &name : names)
+        m_segments.append(dir.filePath(name));
+
+    if (m_segments.isEmpty()) {
+        qWarning() << "CaptureReader: kayıt bulunamadı:" << directory;
+        return false;
+    }
+    if (!mapSegment(0)) {
+        m_segments.clear();
+        return false;
+    }
+    return true;
+}
+
+void CaptureReader::close()
+{
+    unmapSegment();
+    m_segments.clear();
+    m_segmentIndex = -1;
+}
+
+void CaptureReader::rewind()
+{
+    if (isOpen())
+        mapSegment(0);
+}
+
+bool CaptureReader::next(CaptureRecord &record)
+{
+    while (m_base) {
+        Capture::RecordHeader header;
+        if (m_offset + static_cast<qint64>(sizeof(header)) <= m_size) {
+            std::memcpy(&header, m_base + m_offset, sizeof(header));
+            const qint64 end = m_offset + static_cast<qint64>(sizeof(header)) + header.length;
+            if (header.length > 0 && end <= m_size) {
+                record.timestampNs = header.timestampNs;
+                record.data = reinterpret_cast<const char *>(m_base + m_offset + sizeof(header));
+                record.size = static_cast<int>(header.length);
+                m_offset = end;
+                return true;
+            }
+        }
+
+        // Segment sonu (ya da yarım yazılmış kayıt): sıradakine geç
+        if (m_segmentIndex + 1 >= m_segments.size() || !mapSegment(m_segmentIndex + 1)) {
+            unmapSegment();
+            return false;
+        }
+    }
+    return false;
+}
+
+bool CaptureReader::mapSegment(int index)
+{
+    unmapSegment();
+
+    m_file.setFileName(m_segments.at(index));
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "CaptureReader: segment açılamadı:" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    m_base = m_size >= static_cast<qint64>(sizeof(Capture::SegmentHeader)) ? m_file.map(0, m_size) : nullptr;
+    if (!m_base) {
+        qWarning() << "CaptureReader: segment belleğe eşlenemedi:" << m_file.fileName();
+        m_file.close();
+        return false;
+    }
+
+    Capture::SegmentHeader header;
+    std::memcpy(&header, m_base, sizeof(header));
+    if (std::memcmp(header.magic, Capture::Magic, sizeof(header.magic)) != 0
+        || header.headerSize < sizeof(Capture::SegmentHeader)) {
+        qWarning() << "CaptureReader: geçersiz segment başlığı:" << m_file.fileName();
+        unmapSegment();
+        return false;
+    }
+
+    m_segmentIndex = index;
+    m_startedAtMs = header.startedAtMs;
+    m_offset = header.headerSize;
+    return true;
+}
+
+void CaptureReader::unmapSegment()
+{
+    if (m_base) {
+        m_file.unmap(const_cast<uchar *>(m_base));
+        m_base = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+    m_size = 0;
+    m_offset = 0;
+}
@@ -0,0 +1,141 @@
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <atomic>
+
+// Ham seri port kaydı: bir oturum dizini içinde sabit boyutlu, bellek eşlemeli segmentler.
+//
+//   <dizin>/segment_000000.bcap, segment_000001.bcap, ...
+//
+// Segment: 32 baytlık başlık + art arda kayıtlar. Kayıt: 16 baytlık başlık
+// (monoton zaman damgası ns, uzunluk) + ham baytlar. Dosya önceden sıfırla
+// ayrıldığından uzunluğu 0 olan kayıt segmentin sonudur; uygulama çökse bile
+// yazılmış kayıtlar okunabilir. Zaman damgaları kayıt başından itibaren
+// (QElapsedTimer) ölçülür ve segmentler boyunca monoton artar.
+namespace Capture {
+
+constexpr char Magic[8] = {'B', 'L', 'C', 'A', 'P', 'v', '1', '\0'};
+
+struct SegmentHeader {
+    char magic[8];
+    qint64 startedAtMs;   // oturum başlangıcı (milliseconds since epoch)
+    quint32 segmentIndex;
+    quint32 headerSize;   // sizeof(SegmentHeader)
+    quint64 reserved;
+};
+static_assert(sizeof(SegmentHeader) == 32, "SegmentHeader 32 bayt olmalı");
+
+struct RecordHeader {
+    qint64 timestampNs;   // oturum başından itibaren monoton
+    quint32 length;       // 0: segment sonu
+    quint32 reserved;
+};
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader 16 bayt olmalı");
+
+QString segmentFileName(const QString &directory, quint32 index);
+
+} // namespace Capture
+
+// Okuma yolundan çağrılır: her kayıt eşlenmiş belleğe tek memcpy'dir, sistem
+// çağrısı yapılmaz. Segment (varsayılan 16 MB, 375000 baud'da ~7 dakika) %75 dolunca
+// sıradaki segment düşük öncelikli yardımcı thread'de açılıp eşlenir; segment değişimi
+// okuma yolunda yalnızca işaretçi takasıdır, dolan segment de yardımcıda kapatılır.
+class CaptureWriter
+{
+public:
+    static constexpr qint64 DefaultSegmentSize = 16 * 1024 * 1024;
+    // Doluluk bu orana ulaşınca sıradaki segment hazırlanır
+    static constexpr double PrepareThreshold = 0.75;
+
+    explicit CaptureWriter(qint64 segmentSize = DefaultSegmentSize);
+    ~CaptureWriter();
+
+    // directory yoksa oluşturulur; içindeki eski segmentlerin üzerine yazılır
+    bool open(const QString &directory);
+    void close();
+    bool isOpen() const { return m_current.base != nullptr; }
+
+    bool append(const char *data, int size);
+
+    QString directory() const { return m_directory; }
+    quint64 bytesWritten() const { return m_bytesWritten; }
+    quint64 recordCount() const { return m_recordCount; }
+    // Sıradaki segment hazır olmadan dolan segment sayısı (okuma yolu yardımcıyı bekledi)
+    quint64 stalledSwitches() const { return m_stalledSwitches; }
+
+private:
+    struct Segment {
+        QFile *file = nullptr;
+        uchar *base = nullptr;
+        quint32 index = 0;
+    };
+
+    // Her iki thread'den çağrılır; yalnızca open() ile değişen alanları okur
+    Segment openSegment(quint32 index) const;
+    static void closeSegment(const Segment &segment, qint64 usedBytes);
+    void requestNextSegment();
+    bool switchSegment();
+
+    qint64 m_segmentSize;
+    qint64 m_prepareOffset;
+    QString m_directory;
+    Segment m_current;
+    qint64 m_offset = 0;
+    qint64 m_startedAtMs = 0;
+    QElapsedTimer m_clock;
+
+    // Tek thread'li yardımcı havuz: segment hazırlama ve kapatma sırayla çalışır.
+    // m_standby yardımcıda yazılır, m_standbyReady true görüldükten sonra okunur.
+    QThreadPool m_helper;
+    Segment m_standby;
+    std::atomic<bool> m_standbyReady{false};
+    bool m_standbyRequested = false;
+
+    quint64 m_bytesWritten = 0;
+    quint64 m_recordCount = 0;
+    quint64 m_stalledSwitches = 0;
+};
+
+struct CaptureRecord {
+    qint64 timestampNs = 0;
+    const char *data = nullptr; // bir sonraki next() çağrısına kadar geçerli
+    int size = 0;
+};
+
+// Bir oturum dizinini segment segment eşleyerek sırayla okur.
+class CaptureReader
+{
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+
+    bool open(const QString &directory);
+    void close();
+    bool isOpen() const { return !m_segments.isEmpty(); }
+    void rewind();
+
+    bool next(CaptureRecord &record);
+
+    qint64 startedAtMs() const { return m_startedAtMs; }
+    int segmentCount() const { return m_segments.size(); }
+
+private:
+    bool mapSegment(int index);
+    void unmapSegment();
+
+    QStringList m_segments;
+    int m_segmentIndex = -1;
+    QFile m_file;
+    const uchar *m_base = nullptr;
+    qint64 m_size = 0;
+    qint64 m_offset = 0;
+    qint64 m_startedAtMs = 0;
+};
+
+#endif // CAPTUREFILE_H
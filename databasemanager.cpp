@@ -8,11 +8,18 @@ DatabaseManager::DatabaseManager(QObject *parent)
     , m_isReady(false)
 {
     setupWorker();
+    setupReaders(DefaultReaderCount);
 }
 
 DatabaseManager::~DatabaseManager()
 {
+    stopReaders();
+
     if (m_workerThread) {
+        // Kuyruktaki ölçümler thread durmadan önce yazılır
+        if (m_worker && m_workerThread->isRunning())
+            QMetaObject::invokeMethod(m_worker, &DatabaseWorker::flushMeasurements, Qt::BlockingQueuedConnection);
+
         m_workerThread->quit();
         if (!m_workerThread->wait(3000)) {
             qWarning() << "DatabaseManager: Worker thread sonlandırılamadı, zorla kapatılıyor";
@@ -32,6 +39,9 @@ DatabaseManager::~DatabaseManager()
 
 void DatabaseManager::setupWorker()
 {
+    // Satır partileri thread'ler arasında queued bağlantıyla taşınır
+    qRegisterMetaType<MeasurementBatch>();
+
     // Worker thread oluştur
     m_workerThread = new QThread(this);
     m_worker = new DatabaseWorker();
@@ -46,13 +56,16 @@ void DatabaseManager::setupWorker()
             m_worker, &DatabaseWorker::addPatient);
     connect(this, &DatabaseManager::requestSaveMeasurement,
             m_worker, &DatabaseWorker::saveMeasurement);
-    connect(this, &DatabaseManager::requestLoadAllData,
-            m_worker, &DatabaseWorker::loadAllData);
-    connect(this, &DatabaseManager::requestLoadFilteredData,
-            m_worker, &DatabaseWorker::loadFilteredData);
+    connect(this, &DatabaseManager::requestIngestPolicy,
+            m_worker, &DatabaseWorker::setIngestPolicy);
+    connect(this, &DatabaseManager::requestFlushMeasurements,
+            m_worker, &DatabaseWorker::flushMeasurements);
 
     // Sinyalleri bağla - Worker'dan Manager'a (ve dışarı aktar)
     connect(m_worker, &DatabaseWorker::databaseReady, this, [this]() {
+        // Şema güncel: okuyucular bağlantılarını açar; sonraki okumalar kuyrukta bunun arkasındadır
+        for (const Reader &r : std::as_const(m_readers))
+            QMetaObject::invokeMethod(r.reader, &DatabaseReader::initializeDatabase);
         m_isReady = true;
         emit databaseReady();
         qDebug() << "DatabaseManager: Veritabanı hazır";
@@ -60,12 +73,10 @@ void DatabaseManager::setupWorker()
 
     connect(m_worker, &DatabaseWorker::patientAdded,
             this, &DatabaseManager::patientAdded);
-    connect(m_worker, &DatabaseWorker::measurementSaved,
-            this, &DatabaseManager::measurementSaved);
-    connect(m_worker, &DatabaseWorker::dataLoaded,
-            this, &DatabaseManager::dataLoaded);
-    connect(m_worker, &DatabaseWorker::filteredDataLoaded,
-            this, &DatabaseManager::filteredDataLoaded);
+    connect(m_worker, &DatabaseWorker::measurementsSaved,
+            this, &DatabaseManager::measurementsSaved);
+    connect(m_worker, &DatabaseWorker::measurementsInserted,
+            this, &DatabaseManager::measurementsInserted);
     connect(m_worker, &DatabaseWorker::error,
             this, &DatabaseManager::error);
 
@@ -97,31 +108,122 @@ void DatabaseManager::saveMeasurement(int patientId, int spo2, int pr)
 {
     if (!m_isReady) {
         qWarning() << "DatabaseManager: Veritabanı henüz hazır değil";
-        emit measurementSaved(false);
+        emit measurementsSaved(1, false);
         return;
     }
 
     emit requestSaveMeasurement(patientId, spo2, pr);
 }
 
-void DatabaseManager::loadAllData()
+void DatabaseManager::setIngestPolicy(int flushIntervalMs, int maxBatchSize)
+{
+    // Hazır olmadan da gönderilebilir: kuyruktaki sıra initializeDatabase'ten sonradır
+    emit requestIngestPolicy(flushIntervalMs, maxBatchSize);
+}
+
+void DatabaseManager::flushMeasurements()
+{
+    emit requestFlushMeasurements();
+}
+
+void DatabaseManager::setupReaders(int count)
+{
+    m_readers.resize(qMax(1, count));
+    for (int i = 0; i < m_readers.size(); ++i) {
+        Reader &r = m_readers[i];
+        r.thread = new QThread(this);
+        r.reader = new DatabaseReader();
+        r.reader->moveToThread(r.thread);
+
+        connect(r.reader, &DatabaseReader::pageLoaded, this,
+                [this, i](int channel, int requestId, const MeasurementBatch &rows, bool hasMore) {
+            endQuery(i);
+            emit pageLoaded(channel, requestId, rows, hasMore);
+        });
+        connect(r.reader, &DatabaseReader::resultChunk,
+                this, &DatabaseManager::resultChunk);
+        connect(r.reader, &DatabaseReader::resultFinished, this,
+                [this, i](int channel, int queryId, int totalRows, bool success) {
+            endQuery(i);
+            emit resultFinished(channel, queryId, totalRows, success);
+        });
+        connect(r.reader, &DatabaseReader::error,
+                this, &DatabaseManager::error);
+        connect(r.thread, &QThread::finished,
+                r.reader, &DatabaseReader::deleteLater);
+
+        r.thread->start();
+    }
+
+    qDebug() << "DatabaseManager:" << m_readers.size() << "okuyucu thread başlatıldı";
+}
+
+void DatabaseManager::stopReaders()
+{
+    for (Reader &r : m_readers) {
+        // Akmakta olan sonuç bir sonraki satırda kesilir
+        r.reader->cancelAll();
+        r.thread->quit();
+        if (!r.thread->wait(3000)) {
+            qWarning() << "DatabaseManager: Okuyucu thread sonlandırılamadı, zorla kapatılıyor";
+            r.thread->terminate();
+            r.thread->wait(1000);
+        }
+        r.thread->deleteLater();
+    }
+    m_readers.clear();
+}
+
+void DatabaseManager::loadPage(int channel, int requestId, int spo2Min, int spo2Max, int prMin, int prMax,
+                               qint64 beforeTimestampMs, qint64 beforeId, int limit)
 {
     if (!m_isReady) {
         qWarning() << "DatabaseManager: Veritabanı henüz hazır değil";
-        emit dataLoaded(QVariantList());
+        emit pageLoaded(channel, requestId, MeasurementBatch(), false);
         return;
     }
 
-    emit requestLoadAllData();
+    DatabaseReader *reader = beginQuery(channel, requestId);
+    QMetaObject::invokeMethod(reader, [=]() {
+        reader->loadPage(channel, requestId, spo2Min, spo2Max, prMin, prMax, beforeTimestampMs, beforeId, limit);
+    });
 }
 
-void DatabaseManager::loadFilteredData(int spo2Min, int spo2Max, int prMin, int prMax)
+void DatabaseManager::loadMeasurements(int channel, int queryId, int spo2Min, int spo2Max, int prMin, int prMax)
 {
     if (!m_isReady) {
         qWarning() << "DatabaseManager: Veritabanı henüz hazır değil";
-        emit filteredDataLoaded(QVariantList());
+        emit resultFinished(channel, queryId, 0, false);
         return;
     }
 
-    emit requestLoadFilteredData(spo2Min, spo2Max, prMin, prMax);
+    DatabaseReader *reader = beginQuery(channel, queryId);
+    QMetaObject::invokeMethod(reader, [=]() {
+        reader->loadFilteredData(channel, queryId, spo2Min, spo2Max, prMin, prMax);
+    });
+}
+
+DatabaseReader *DatabaseManager::beginQuery(int channel, int queryId)
+{
+    // Okuyucu thread'leri meşgulken de hemen görünür (atomik); kuyruk sırasını beklemez.
+    // Kanalın eski isteği herhangi bir okuyucuda olabilir, her okuyucuya yayınlanır
+    int target = 0;
+    for (int i = 0; i < m_readers.size(); ++i) {
+        m_readers[i].reader->setLatestQuery(channel, queryId);
+        if (m_readers[i].pending < m_readers[target].pending)
+            target = i;
+    }
+
+    ++m_readers[target].pending;
+    ++m_pendingQueries;
+    emit pendingQueriesChanged(m_pendingQueries);
+    return m_readers[target].reader;
+}
+
+void DatabaseManager::endQuery(int readerIndex)
+{
+    if (readerIndex < m_readers.size())
+        m_readers[readerIndex].pending = qMax(0, m_readers[readerIndex].pending - 1);
+    m_pendingQueries = qMax(0, m_pendingQueries - 1);
+    emit pendingQueriesChanged(m_pendingQueries);
 }
@@ -3,50 +3,82 @@
 
 #include <QObject>
 #include <QThread>
-#include <QVariantList>
-#include <QVariantMap>
 #include <QMutex>
+#include <QVector>
 #include "databaseworker.h"
+#include "databasereader.h"
 
+// Tek yazar (DatabaseWorker) ve küçük bir salt okunur bağlantı havuzu (DatabaseReader), her
+// biri kendi thread'inde. Kayıt ve okumalar ayrı kuyruklarda ilerler; okuma istekleri en az
+// bekleyen işi olan okuyucuya gider. Her okuma bir kanal (DatabaseReader::Channel) taşır:
+// liste, dışa aktarım ve analiz sorguları paralel çalışır, yalnızca aynı kanalın eski
+// sorguları iptal edilir.
 class DatabaseManager : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr int DefaultReaderCount = 2;
+
     explicit DatabaseManager(QObject *parent = nullptr);
     ~DatabaseManager();
 
     // Async metodlar - thread'e istek gönderir
     void addPatient(const QString &firstName, const QString &lastName);
     void saveMeasurement(int patientId, int spo2, int pr);
-    void loadAllData();
-    void loadFilteredData(int spo2Min, int spo2Max, int prMin, int prMax);
+    // Toplu kayıt politikası (bkz. DatabaseWorker); flushIntervalMs <= 0 her satırı hemen yazar
+    void setIngestPolicy(int flushIntervalMs, int maxBatchSize);
+    void flushMeasurements();
+    // Keyset sayfalama (bkz. DatabaseReader::loadPage)
+    void loadPage(int channel, int requestId, int spo2Min, int spo2Max, int prMin, int prMax,
+                  qint64 beforeTimestampMs, qint64 beforeId, int limit);
+    // Süzgeçli sonucun tamamı parça parça akar (bkz. DatabaseReader::loadFilteredData)
+    void loadMeasurements(int channel, int queryId, int spo2Min, int spo2Max, int prMin, int prMax);
 
     // Durum kontrolü
     bool isReady() const { return m_isReady; }
+    // Okuyuculara gönderilmiş, yanıtı henüz gelmemiş okuma istekleri (çalışanlar dahil)
+    int pendingQueries() const { return m_pendingQueries; }
 
 signals:
-    // DatabaseWorker'dan gelen sinyalleri dışarı aktar
+    // DatabaseWorker ve okuyuculardan gelen sinyalleri dışarı aktar
     void databaseReady();
     void patientAdded(int newPatientId, bool success);
-    void measurementSaved(bool success);
-    void dataLoaded(const QVariantList &data);
-    void filteredDataLoaded(const QVariantList &data);
+    void measurementsSaved(int count, bool success);
+    void measurementsInserted(const MeasurementBatch &rows);
+    void pageLoaded(int channel, int requestId, const MeasurementBatch &rows, bool hasMore);
+    void resultChunk(int channel, int queryId, int sequence, const MeasurementBatch &rows);
+    void resultFinished(int channel, int queryId, int totalRows, bool success);
+    void pendingQueriesChanged(int count);
     void error(const QString &message);
 
     // Worker'a sinyal gönder
     void initializeDatabase();
     void requestAddPatient(const QString &firstName, const QString &lastName);
     void requestSaveMeasurement(int patientId, int spo2, int pr);
-    void requestLoadAllData();
-    void requestLoadFilteredData(int spo2Min, int spo2Max, int prMin, int prMax);
+    void requestIngestPolicy(int flushIntervalMs, int maxBatchSize);
+    void requestFlushMeasurements();
 
 private:
     QThread *m_workerThread;
     DatabaseWorker *m_worker;
     bool m_isReady;
+    int m_pendingQueries = 0;
+
+    struct Reader {
+        QThread *thread = nullptr;
+        DatabaseReader *reader = nullptr;
+        int pending = 0; // yanıtı beklenen istekler
+    };
+    QVector<Reader> m_readers;
 
     void setupWorker();
+    void setupReaders(int count);
+    void stopReaders();
+    // Aynı kanalda queryId'den eski istekler okuyucularda çalıştırılmaz ya da yarıda kesilir;
+    // diğer kanallar etkilenmez. Dönen değer isteğin gönderileceği okuyucudur
+    DatabaseReader *beginQuery(int channel, int queryId);
+    void endQuery(int readerIndex);
 };
 
 #endif // DATABASEMANAGER_H
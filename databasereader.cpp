@@ -0,0 +1,288 @@
+#include "databasereader.h"
+#include <QSqlError>
+#include <QDebug>
+#include <QUuid>
+
+namespace {
+
+// MeasurementBatch::Column sırası; hasta adları satır başına JOIN yerine PatientNameCache'ten
+const char *const MeasurementColumns =
+    "SELECT m.id, m.patient_id, m.spo2, m.pr, m.timestamp_ms "
+    "FROM measurements m ";
+
+// Etkin olmayan filtre sınırı NULL bağlanır; koşul "(? IS NULL OR ...)" ile devre dışı kalır
+QVariant boundOrNull(bool active, int value)
+{
+    return active ? QVariant(value) : QVariant(QMetaType::fromType<int>());
+}
+
+} // namespace
+
+DatabaseReader::Statements::Statements(const QSqlDatabase &db)
+    : selectAll(db)
+    , pageAll(db)
+    , pageFiltered(db)
+    , patientNames(db)
+{
+}
+
+bool DatabaseReader::Statements::prepare()
+{
+    selectAll.setForwardOnly(true);
+    pageAll.setForwardOnly(true);
+    pageFiltered.setForwardOnly(true);
+
+    // Filtre tek sabit biçimdir: etkin olmayan sınırlar NULL ile bağlanır ("? IS NULL OR ..."
+    // devre dışı kalır). Süzgeçli akış da aynı sayfa sorgusunu imleçsiz ve sınırsız kullanır.
+    return selectAll.prepare(QString(MeasurementColumns) + "ORDER BY m.timestamp_ms DESC")
+        && patientNames.prepare()
+        // Sayfalar zaman indeksinden sırayla okunur (timestamp_ms, rowid); LIMIT'e ulaşınca durur.
+        // Süzgeçli sayfada aralık indeksleri kullanılmaz: sıralama için tüm eşleşenleri okumak gerekirdi.
+        // LIMIT -1: sınırsız (loadFilteredData akışı).
+        && pageAll.prepare(QString(MeasurementColumns)
+                           + "WHERE (m.timestamp_ms, m.id) < (?, ?) "
+                             "ORDER BY m.timestamp_ms DESC, m.id DESC LIMIT ?")
+        && pageFiltered.prepare(QString(MeasurementColumns)
+                                + "WHERE (m.timestamp_ms, m.id) < (?, ?) "
+                                  "AND (? IS NULL OR m.spo2 >= ?) "
+                                  "AND (? IS NULL OR m.spo2 <= ?) "
+                                  "AND (? IS NULL OR m.pr >= ?) "
+                                  "AND (? IS NULL OR m.pr <= ?) "
+                                  "ORDER BY m.timestamp_ms DESC, m.id DESC LIMIT ?");
+}
+
+DatabaseReader::DatabaseReader(QObject *parent)
+    : QObject(parent)
+{
+    // Her okuyucu kendi bağlantısını kendi thread'inde açar
+    m_connectionName = QString("DatabaseReader_%1").arg(QUuid::createUuid().toString());
+}
+
+DatabaseReader::~DatabaseReader()
+{
+    closeDatabase();
+}
+
+void DatabaseReader::cancelAll()
+{
+    for (QAtomicInt &latest : m_latestQuery)
+        latest.storeRelease(std::numeric_limits<int>::max());
+}
+
+void DatabaseReader::initializeDatabase()
+{
+    m_db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_db.setDatabaseName("patients.db");
+    // Yazar dosyayı WAL'e almıştır; salt okunur bağlantı yazma kilidi almaz
+    m_db.setConnectOptions("QSQLITE_OPEN_READONLY");
+
+    if (!m_db.open()) {
+        QString errorMsg = QString("Okuma bağlantısı açılamadı: %1").arg(m_db.lastError().text());
+        qCritical() << errorMsg;
+        emit error(errorMsg);
+        return;
+    }
+
+    m_statements = std::make_unique<Statements>(m_db);
+    if (!m_statements->prepare()) {
+        QString errorMsg = QString("Okuma sorguları hazırlanamadı: %1").arg(m_db.lastError().text());
+        qCritical() << errorMsg;
+        m_statements.reset();
+        emit error(errorMsg);
+        return;
+    }
+
+    qDebug() << "DatabaseReader: Salt okunur bağlantı açıldı";
+}
+
+MeasurementBatch DatabaseReader::readRows(QSqlQuery &q)
+{
+    MeasurementBatch batch;
+    while (q.next())
+        batch.appendFromQuery(q);
+    // Hazır sorgu bir sonraki çağrıda yeniden bağlanabilsin
+    q.finish();
+    m_statements->patientNames.attach(batch);
+    return batch;
+}
+
+void DatabaseReader::loadAllData(int channel, int queryId)
+{
+    if (isSuperseded(channel, queryId)) {
+        qDebug() << "DatabaseReader: Sorgu" << queryId << "eskidi, çalıştırılmadı";
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    if (!m_statements) {
+        qWarning() << "DatabaseReader: Veritabanı bağlantısı kapalı";
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    QSqlQuery &q = m_statements->selectAll;
+    if (!q.exec()) {
+        QString errorMsg = QString("loadAllData SQL hatası: %1").arg(q.lastError().text());
+        qCritical() << errorMsg;
+        emit error(errorMsg);
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    streamRows(channel, queryId, q);
+}
+
+void DatabaseReader::loadFilteredData(int channel, int queryId, int spo2Min, int spo2Max, int prMin, int prMax)
+{
+    if (isSuperseded(channel, queryId)) {
+        qDebug() << "DatabaseReader: Sorgu" << queryId << "eskidi, çalıştırılmadı";
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    if (!m_statements) {
+        qWarning() << "DatabaseReader: Veritabanı bağlantısı kapalı";
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    // Sayfa sorgusu imleçsiz ve sınırsız (LIMIT -1): zaman indeksinden sırayla okunduğu için
+    // ilk eşleşen satırlar hemen gelir; aralık indeksi önce tüm eşleşenleri sıralamak zorundadır
+    QSqlQuery &q = bindPage(spo2Min, spo2Max, prMin, prMax,
+                            FirstPageCursor, FirstPageCursor, -1);
+
+    if (!q.exec()) {
+        QString errorMsg = QString("loadFilteredData SQL hatası: %1").arg(q.lastError().text());
+        qWarning() << errorMsg;
+        emit error(errorMsg);
+        emit resultFinished(channel, queryId, 0, false);
+        return;
+    }
+
+    streamRows(channel, queryId, q);
+}
+
+void DatabaseReader::streamRows(int channel, int queryId, QSqlQuery &q)
+{
+    MeasurementBatch chunk;
+    chunk.reserve(StreamChunkRows);
+    int sequence = 0;
+    int totalRows = 0;
+    bool cancelled = false;
+
+    while (q.next()) {
+        // Yeni bir sorgu geldiyse bu sonuç artık kimsenin işine yaramaz
+        if (isSuperseded(channel, queryId)) {
+            cancelled = true;
+            break;
+        }
+        chunk.appendFromQuery(q);
+        if (chunk.size() == StreamChunkRows) {
+            m_statements->patientNames.attach(chunk);
+            totalRows += chunk.size();
+            emit resultChunk(channel, queryId, sequence++, chunk);
+            // Gönderilen parçanın dizileri alıcıyla paylaşılır; yenisi ayrı bellekte dolar
+            chunk = MeasurementBatch();
+            chunk.reserve(StreamChunkRows);
+        }
+    }
+    const QSqlError readError = q.lastError();
+    q.finish();
+
+    if (cancelled) {
+        qDebug() << "DatabaseReader: Sorgu" << queryId << "iptal edildi," << totalRows << "satır gönderilmişti";
+        emit resultFinished(channel, queryId, totalRows, false);
+        return;
+    }
+
+    const bool success = !readError.isValid();
+    if (!chunk.isEmpty()) {
+        m_statements->patientNames.attach(chunk);
+        totalRows += chunk.size();
+        emit resultChunk(channel, queryId, sequence++, chunk);
+    }
+
+    if (!success) {
+        QString errorMsg = QString("Sonuç okunamadı: %1").arg(readError.text());
+        qWarning() << errorMsg;
+        emit error(errorMsg);
+    }
+    qDebug() << "DatabaseReader: Sorgu" << queryId << "tamamlandı, kayıt sayısı:" << totalRows
+             << "parça:" << sequence;
+    emit resultFinished(channel, queryId, totalRows, success);
+}
+
+QSqlQuery &DatabaseReader::bindPage(int spo2Min, int spo2Max, int prMin, int prMax,
+                                    qint64 beforeTimestampMs, qint64 beforeId, int limit)
+{
+    // Geçersiz ya da 0 sınırlar etkin değildir
+    const bool spo2MinActive = spo2Min > 0;
+    const bool spo2MaxActive = spo2Max > 0 && spo2Max <= 100;
+    const bool prMinActive = prMin > 0;
+    const bool prMaxActive = prMax > 0 && prMax <= 300;
+    const bool filtered = spo2MinActive || spo2MaxActive || prMinActive || prMaxActive;
+
+    QSqlQuery &q = filtered ? m_statements->pageFiltered : m_statements->pageAll;
+    int bind = 0;
+    q.bindValue(bind++, beforeTimestampMs);
+    q.bindValue(bind++, beforeId);
+    if (filtered) {
+        const QVariant bounds[] = {
+            boundOrNull(spo2MinActive, spo2Min),
+            boundOrNull(spo2MaxActive, spo2Max),
+            boundOrNull(prMinActive, prMin),
+            boundOrNull(prMaxActive, prMax),
+        };
+        for (const QVariant &bound : bounds) {
+            q.bindValue(bind++, bound);
+            q.bindValue(bind++, bound);
+        }
+    }
+    q.bindValue(bind, limit);
+    return q;
+}
+
+void DatabaseReader::loadPage(int channel, int requestId, int spo2Min, int spo2Max, int prMin, int prMax,
+                              qint64 beforeTimestampMs, qint64 beforeId, int limit)
+{
+    if (isSuperseded(channel, requestId)) {
+        qDebug() << "DatabaseReader: Sayfa isteği" << requestId << "eskidi, çalıştırılmadı";
+        emit pageLoaded(channel, requestId, MeasurementBatch(), false);
+        return;
+    }
+
+    if (!m_statements) {
+        qWarning() << "DatabaseReader: Veritabanı bağlantısı kapalı";
+        emit pageLoaded(channel, requestId, MeasurementBatch(), false);
+        return;
+    }
+
+    limit = qMax(1, limit);
+    // Bir fazla satır: sonraki sayfanın varlığı ayrı COUNT sorgusu olmadan anlaşılır
+    QSqlQuery &q = bindPage(spo2Min, spo2Max, prMin, prMax, beforeTimestampMs, beforeId, limit + 1);
+
+    if (!q.exec()) {
+        QString errorMsg = QString("loadPage SQL hatası: %1").arg(q.lastError().text());
+        qWarning() << errorMsg;
+        emit error(errorMsg);
+        emit pageLoaded(channel, requestId, MeasurementBatch(), false);
+        return;
+    }
+
+    MeasurementBatch rows = readRows(q);
+    const bool hasMore = rows.size() > limit;
+    if (hasMore)
+        rows.removeLast();
+    emit pageLoaded(channel, requestId, rows, hasMore);
+}
+
+void DatabaseReader::closeDatabase()
+{
+    // Hazır sorgular bağlantıdan önce bırakılır
+    m_statements.reset();
+
+    if (m_db.isOpen())
+        m_db.close();
+
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
@@ -0,0 +1,95 @@
+#ifndef DATABASEREADER_H
+#define DATABASEREADER_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QAtomicInt>
+#include <limits>
+#include <memory>
+#include "measurementbatch.h"
+
+// Salt okunur veritabanı bağlantısı: liste sayfaları ve akış sorguları. DatabaseManager bir
+// kaç okuyucuyu ayrı thread'lerde çalıştırır; WAL'de okuyucular yazarı (DatabaseWorker) ve
+// birbirini beklemez, her sorgu başladığı andaki anlık görüntüyü okur.
+// initializeDatabase yazar şemayı güncelledikten (databaseReady) sonra çağrılmalıdır.
+class DatabaseReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Okuma kanalı: "en son sorgu kazanır" kanal başına izlenir. Bir kanalın yeni sorgusu yalnızca
+    // aynı kanalın eski sorgularını iptal eder; liste yenilemesi akan bir dışa aktarımı kesmez.
+    // Sorgu id'leri kanal içinde artan nesil sayacıdır (kanallar arasında bağımsız).
+    enum Channel {
+        ListChannel = 0,  // geçmiş listesi (MeasurementListModel)
+        ExportChannel,    // dışa aktarım ve raporlar
+        AnalyticsChannel, // analiz sorguları
+        ChannelCount
+    };
+
+    static constexpr qint64 FirstPageCursor = std::numeric_limits<qint64>::max();
+    // Akış sonucu bu boyutta parçalar halinde gönderilir; okuyucuda aynı anda tek parça tutulur
+    static constexpr int StreamChunkRows = 1000;
+
+    explicit DatabaseReader(QObject *parent = nullptr);
+    ~DatabaseReader();
+
+    // Thread-safe: channel kanalında queryId'si bundan küçük okuma istekleri eskimiştir. Kuyrukta
+    // bekleyenler çalıştırılmadan, akmakta olan sonuç bir sonraki satırda kesilir (success false).
+    void setLatestQuery(int channel, int queryId) { m_latestQuery[channel].storeRelease(queryId); }
+    // Tüm kanallardaki istekleri eskitir (kapanış)
+    void cancelAll();
+
+public slots:
+    void initializeDatabase();
+    // Sonuç StreamChunkRows satırlık parçalar halinde akar (resultChunk), ardından resultFinished.
+    // İlk parça ilk satırlar okunur okunmaz gider; sonucun tamamı hiçbir zaman bellekte toplanmaz.
+    void loadAllData(int channel, int queryId);
+    void loadFilteredData(int channel, int queryId, int spo2Min, int spo2Max, int prMin, int prMax);
+    // Keyset sayfalama: (timestamp_ms, id) < (beforeTimestampMs, beforeId) olan en yeni limit satır.
+    // İlk sayfa için imleç FirstPageCursor; sonraki sayfada imleç önceki sayfanın son satırıdır.
+    // Maliyet tablo boyutundan değil sayfa boyutundan bağımsızdır (OFFSET yok).
+    void loadPage(int channel, int requestId, int spo2Min, int spo2Max, int prMin, int prMax,
+                  qint64 beforeTimestampMs, qint64 beforeId, int limit);
+
+signals:
+    // Yanıtlar isteğin kanalını taşır; alıcı kendi kanalı ve id'si dışındakileri yok sayar.
+    // sequence 0'dan başlar; parçalar sırayla gelir (aynı thread'den queued bağlantı)
+    void resultChunk(int channel, int queryId, int sequence, const MeasurementBatch &rows);
+    // Akışın sonu: totalRows gönderilen satır sayısı; success false ise akış yarıda kesildi
+    void resultFinished(int channel, int queryId, int totalRows, bool success);
+    // requestId loadPage'den aynen döner; hasMore: imleçten sonra başka satır var
+    void pageLoaded(int channel, int requestId, const MeasurementBatch &rows, bool hasMore);
+    void error(const QString &message);
+
+private:
+    // Bağlantı ömrü boyunca hazır tutulan sorgular; filtre sorgusu sabit biçimlidir
+    // (etkin olmayan sınır NULL)
+    struct Statements {
+        explicit Statements(const QSqlDatabase &db);
+        bool prepare();
+
+        QSqlQuery selectAll;
+        QSqlQuery pageAll;
+        QSqlQuery pageFiltered;
+        PatientNameCache patientNames;
+    };
+
+    QSqlDatabase m_db;
+    std::unique_ptr<Statements> m_statements;
+    QString m_connectionName;
+    QAtomicInt m_latestQuery[ChannelCount];
+
+    void closeDatabase();
+    // Sorgu sonucunu okur, hasta adlarını ekler ve sorguyu yeniden kullanıma hazırlar (finish)
+    MeasurementBatch readRows(QSqlQuery &q);
+    bool isSuperseded(int channel, int queryId) const { return queryId < m_latestQuery[channel].loadAcquire(); }
+    // Filtreye göre pageAll ya da pageFiltered'i bağlar (limit -1: sınırsız)
+    QSqlQuery &bindPage(int spo2Min, int spo2Max, int prMin, int prMax,
+                        qint64 beforeTimestampMs, qint64 beforeId, int limit);
+    // Çalıştırılmış sorguyu parça parça resultChunk ile gönderir, sonra resultFinished
+    void streamRows(int channel, int queryId, QSqlQuery &q);
+};
+
+#endif // DATABASEREADER_H
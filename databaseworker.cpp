@@ -1,9 +1,80 @@
 #include "databaseworker.h"
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QDateTime>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QStringList>
 #include <QUuid>
 
+namespace {
+
+// Şema geçişleri: PRAGMA user_version, uygulanan son sürümü tutar. Her geçiş kendi
+// transaction'ında çalışır; yarıda kalan geçiş geri alınır ve sonraki açılışta tekrarlanır.
+// Yeni geçişler yalnızca sona eklenir, mevcutlar değiştirilmez.
+struct Migration {
+    int version;
+    const char *description;
+    QStringList statements;
+};
+
+const QList<Migration> &migrations()
+{
+    static const QList<Migration> list = {
+        {1, "temel tablolar",
+         {"CREATE TABLE IF NOT EXISTS patients ("
+          "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+          "first_name TEXT NOT NULL,"
+          "last_name TEXT NOT NULL,"
+          "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+          "CREATE TABLE IF NOT EXISTS measurements ("
+          "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+          "patient_id INTEGER NOT NULL,"
+          "spo2 INTEGER NOT NULL,"
+          "pr INTEGER NOT NULL,"
+          "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP,"
+          "FOREIGN KEY(patient_id) REFERENCES patients(id))"}},
+
+        // DATETIME metni (UTC) -> epoch ms tamsayı; tablo yeniden kurulur, id'ler korunur
+        {2, "ölçüm zamanı epoch ms",
+         {"CREATE TABLE measurements_v2 ("
+          "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+          "patient_id INTEGER NOT NULL,"
+          "spo2 INTEGER NOT NULL,"
+          "pr INTEGER NOT NULL,"
+          "timestamp_ms INTEGER NOT NULL,"
+          "FOREIGN KEY(patient_id) REFERENCES patients(id))",
+          "INSERT INTO measurements_v2 (id, patient_id, spo2, pr, timestamp_ms) "
+          "SELECT id, patient_id, spo2, pr, "
+          "COALESCE(CAST(strftime('%s', timestamp) AS INTEGER), 0) * 1000 FROM measurements",
+          "DROP TABLE measurements",
+          "ALTER TABLE measurements_v2 RENAME TO measurements"}},
+
+        // Liste sıralaması ve hasta geçmişi için. SpO2/PR aralık indeksi yok: süzgeçli sonuç
+        // zaman indeksinden sırayla akar, aralık indeksi önce tüm eşleşenleri sıralamak zorundadır
+        {3, "ölçüm indeksleri",
+         {"CREATE INDEX IF NOT EXISTS idx_measurements_time ON measurements (timestamp_ms)",
+          "CREATE INDEX IF NOT EXISTS idx_measurements_patient_time ON measurements (patient_id, timestamp_ms)"}},
+    };
+    return list;
+}
+
+} // namespace
+
+DatabaseWorker::Statements::Statements(const QSqlDatabase &db)
+    : insertPatient(db)
+    , insertMeasurement(db)
+    , patientNames(db)
+{
+}
+
+bool DatabaseWorker::Statements::prepare()
+{
+    return insertPatient.prepare("INSERT INTO patients (first_name, last_name) VALUES (?, ?)")
+        && insertMeasurement.prepare("INSERT INTO measurements (patient_id, spo2, pr, timestamp_ms) VALUES (?, ?, ?, ?)")
+        && patientNames.prepare();
+}
+
 DatabaseWorker::DatabaseWorker(QObject *parent)
     : QObject(parent)
 {
@@ -20,8 +91,6 @@ void DatabaseWorker::initializeDatabase()
 {
     qDebug() << "DatabaseWorker::initializeDatabase - Thread ID:" << QThread::currentThreadId(); // <-- ekleme
 
-    QMutexLocker locker(&m_mutex);
-
     m_db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
     m_db.setDatabaseName("patients.db");
 
@@ -32,66 +101,104 @@ void DatabaseWorker::initializeDatabase()
         return;
     }
 
-    if (!createTables()) {
-        QString errorMsg = "Veritabanı tabloları oluşturulamadı";
+    // WAL: okuyucular yazarı beklemez; NORMAL: commit başına değil checkpoint'te fsync
+    QSqlQuery pragma(m_db);
+    if (!pragma.exec("PRAGMA journal_mode=WAL") || !pragma.exec("PRAGMA synchronous=NORMAL"))
+        qWarning() << "DatabaseWorker: WAL ayarlanamadı:" << pragma.lastError().text();
+
+    if (!migrateSchema()) {
+        QString errorMsg = "Veritabanı şeması güncellenemedi";
         qCritical() << errorMsg;
         emit error(errorMsg);
         return;
     }
 
+    m_statements = std::make_unique<Statements>(m_db);
+    if (!m_statements->prepare()) {
+        QString errorMsg = QString("Sorgular hazırlanamadı: %1").arg(m_db.lastError().text());
+        qCritical() << errorMsg;
+        m_statements.reset();
+        emit error(errorMsg);
+        return;
+    }
+
+    // Toplu yazım zamanlayıcısı worker thread'inde yaşar
+    if (!m_flushTimer) {
+        m_flushTimer = new QTimer(this);
+        m_flushTimer->setSingleShot(true);
+        connect(m_flushTimer, &QTimer::timeout, this, &DatabaseWorker::flushMeasurements);
+    }
+
     qDebug() << "DatabaseWorker: Veritabanı başarıyla başlatıldı";
     emit databaseReady();
 }
 
-bool DatabaseWorker::createTables()
+bool DatabaseWorker::migrateSchema()
 {
     QSqlQuery q(m_db);
-
-    // Patients tablosu oluştur
-    if (!q.exec("CREATE TABLE IF NOT EXISTS patients ("
-                "id INTEGER PRIMARY KEY AUTOINCREMENT,"
-                "first_name TEXT NOT NULL,"
-                "last_name TEXT NOT NULL,"
-                "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)")) {
-        qCritical() << "Patients tablosu oluşturulamadı:" << q.lastError().text();
+    if (!q.exec("PRAGMA user_version") || !q.next()) {
+        qCritical() << "Şema sürümü okunamadı:" << q.lastError().text();
         return false;
     }
+    const int current = q.value(0).toInt();
+    q.finish();
 
-    // Measurements tablosu oluştur
-    if (!q.exec("CREATE TABLE IF NOT EXISTS measurements ("
-                "id INTEGER PRIMARY KEY AUTOINCREMENT,"
-                "patient_id INTEGER NOT NULL,"
-                "spo2 INTEGER NOT NULL,"
-                "pr INTEGER NOT NULL,"
-                "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP,"
-                "FOREIGN KEY(patient_id) REFERENCES patients(id))")) {
-        qCritical() << "Measurements tablosu oluşturulamadı:" << q.lastError().text();
+    if (current > SchemaVersion) {
+        qCritical() << "Veritabanı şeması bu sürümden yeni: v" << current << "> v" << SchemaVersion;
         return false;
     }
 
+    bool migrated = false;
+    for (const Migration &migration : migrations()) {
+        if (migration.version <= current)
+            continue;
+
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = m_db.transaction();
+        for (const QString &statement : migration.statements) {
+            if (!ok)
+                break;
+            ok = q.exec(statement);
+        }
+        // user_version veritabanı başlığındadır; geçişle birlikte commit edilir
+        ok = ok && q.exec(QString("PRAGMA user_version = %1").arg(migration.version));
+        ok = ok && m_db.commit();
+
+        if (!ok) {
+            qCritical() << "Şema geçişi v" << migration.version << "başarısız:" << q.lastError().text();
+            m_db.rollback();
+            return false;
+        }
+        qDebug() << "DatabaseWorker: Şema v" << migration.version << "(" << migration.description << ")"
+                 << timer.elapsed() << "ms";
+        migrated = true;
+    }
+
+    // Büyük tablo yeniden kurulduysa WAL dosyası bir kez boşaltılır
+    if (migrated && !q.exec("PRAGMA wal_checkpoint(TRUNCATE)"))
+        qWarning() << "DatabaseWorker: WAL checkpoint yapılamadı:" << q.lastError().text();
+
     return true;
 }
 
 void DatabaseWorker::addPatient(const QString &firstName, const QString &lastName)
 {
-    QMutexLocker locker(&m_mutex);
-
     if (firstName.isEmpty() || lastName.isEmpty()) {
         qWarning() << "DatabaseWorker: Ad ve soyad boş olamaz";
         emit patientAdded(-1, false);
         return;
     }
 
-    if (!m_db.isOpen()) {
+    if (!m_statements) {
         qWarning() << "DatabaseWorker: Veritabanı bağlantısı kapalı";
         emit patientAdded(-1, false);
         return;
     }
 
-    QSqlQuery q(m_db);
-    q.prepare("INSERT INTO patients (first_name, last_name) VALUES (:firstName, :lastName)");
-    q.bindValue(":firstName", firstName);
-    q.bindValue(":lastName", lastName);
+    QSqlQuery &q = m_statements->insertPatient;
+    q.bindValue(0, firstName);
+    q.bindValue(1, lastName);
 
     if (!q.exec()) {
         QString errorMsg = QString("Hasta eklenemedi: %1").arg(q.lastError().text());
@@ -102,148 +209,122 @@ void DatabaseWorker::addPatient(const QString &firstName, const QString &lastNam
     }
 
     int newPatientId = q.lastInsertId().toInt();
+    q.finish();
+    m_statements->patientNames.insert(newPatientId, PatientName{firstName, lastName});
     qDebug() << "DatabaseWorker: Yeni hasta eklendi, ID:" << newPatientId;
     emit patientAdded(newPatientId, true);
 }
 
 void DatabaseWorker::saveMeasurement(int patientId, int spo2, int pr)
 {
-    qDebug() << "DatabaseWorker::initializeDatabase - Thread ID:" << QThread::currentThreadId(); // <-- ekleme
-
-    QMutexLocker locker(&m_mutex);
-
     if (patientId <= 0) {
         qWarning() << "DatabaseWorker: Geçersiz hasta ID:" << patientId;
-        emit measurementSaved(false);
-        return;
-    }
-
-    if (!m_db.isOpen()) {
-        qWarning() << "DatabaseWorker: Veritabanı bağlantısı kapalı";
-        emit measurementSaved(false);
+        emit measurementsSaved(1, false);
         return;
     }
 
-    QSqlQuery q(m_db);
-    q.prepare("INSERT INTO measurements (patient_id, spo2, pr) VALUES (:patientId, :spo2, :pr)");
-    q.bindValue(":patientId", patientId);
-    q.bindValue(":spo2", spo2);
-    q.bindValue(":pr", pr);
+    m_pending.append({patientId, spo2, pr, QDateTime::currentMSecsSinceEpoch()});
 
-    if (!q.exec()) {
-        QString errorMsg = QString("Ölçüm kaydedilemedi: %1").arg(q.lastError().text());
-        qCritical() << errorMsg;
-        emit error(errorMsg);
-        emit measurementSaved(false);
-        return;
+    if (m_flushIntervalMs <= 0 || m_pending.size() >= m_maxBatchSize) {
+        flushPending();
+    } else if (m_flushTimer && !m_flushTimer->isActive()) {
+        // İlk bekleyen satır aralığı başlatır: hiçbir satır flushIntervalMs'den uzun beklemez
+        m_flushTimer->start(m_flushIntervalMs);
     }
-
-    qDebug() << "DatabaseWorker: Ölçüm kaydedildi - PatientID:" << patientId << "SpO2:" << spo2 << "PR:" << pr;
-    emit measurementSaved(true);
 }
 
-void DatabaseWorker::loadAllData()
+void DatabaseWorker::setIngestPolicy(int flushIntervalMs, int maxBatchSize)
 {
-    QMutexLocker locker(&m_mutex);
-
-    if (!m_db.isOpen()) {
-        qWarning() << "DatabaseWorker: Veritabanı bağlantısı kapalı";
-        emit dataLoaded(QVariantList());
-        return;
-    }
-
-    QVariantList list;
-    QSqlQuery q(m_db);
-
-    q.prepare("SELECT p.first_name, p.last_name, m.spo2, m.pr, "
-              "strftime('%Y-%m-%d %H:%M:%S', m.timestamp) AS formatted_time "
-              "FROM measurements m "
-              "JOIN patients p ON m.patient_id = p.id "
-              "ORDER BY m.timestamp DESC");
-
-    if (!q.exec()) {
-        QString errorMsg = QString("loadAllData SQL hatası: %1").arg(q.lastError().text());
-        qCritical() << errorMsg;
-        emit error(errorMsg);
-        emit dataLoaded(QVariantList());
-        return;
-    }
+    m_flushIntervalMs = qMax(0, flushIntervalMs);
+    m_maxBatchSize = qMax(1, maxBatchSize);
+    qDebug() << "DatabaseWorker: Toplu kayıt -" << m_flushIntervalMs << "ms /" << m_maxBatchSize << "satır";
 
-    while (q.next()) {
-        QVariantMap record;
-        record["first_name"] = q.value("first_name");
-        record["last_name"] = q.value("last_name");
-        record["spo2"] = q.value("spo2");
-        record["pr"] = q.value("pr");
-        record["timestamp"] = q.value("formatted_time");
-        list.append(record);
-    }
-
-    qDebug() << "DatabaseWorker: Tüm veriler yüklendi, kayıt sayısı:" << list.size();
-    emit dataLoaded(list);
+    if (m_flushIntervalMs == 0 || m_pending.size() >= m_maxBatchSize)
+        flushPending();
 }
 
-void DatabaseWorker::loadFilteredData(int spo2Min, int spo2Max, int prMin, int prMax)
+void DatabaseWorker::flushMeasurements()
 {
-    QMutexLocker locker(&m_mutex);
+    flushPending();
+}
 
-    if (!m_db.isOpen()) {
-        qWarning() << "DatabaseWorker: Veritabanı bağlantısı kapalı";
-        emit filteredDataLoaded(QVariantList());
+void DatabaseWorker::flushPending()
+{
+    // Kuyruk boşken zamanlayıcı da durmuştur
+    if (m_pending.isEmpty())
         return;
-    }
-
-    QVariantList list;
-    QSqlQuery q(m_db);
-
-    QString queryString = "SELECT p.first_name, p.last_name, m.spo2, m.pr, "
-                          "strftime('%Y-%m-%d %H:%M:%S', m.timestamp) AS formatted_time "
-                          "FROM measurements m "
-                          "JOIN patients p ON m.patient_id = p.id "
-                          "WHERE 1=1 ";
+    if (m_flushTimer)
+        m_flushTimer->stop();
 
-    if (spo2Min > 0) queryString += "AND m.spo2 >= :spo2Min ";
-    if (spo2Max > 0 && spo2Max <= 100) queryString += "AND m.spo2 <= :spo2Max ";
-    if (prMin > 0) queryString += "AND m.pr >= :prMin ";
-    if (prMax > 0 && prMax <= 300) queryString += "AND m.pr <= :prMax ";
+    QVector<PendingMeasurement> batch;
+    batch.swap(m_pending);
+    const int count = batch.size();
 
-    queryString += "ORDER BY m.timestamp DESC";
-
-    q.prepare(queryString);
+    if (!m_statements) {
+        qWarning() << "DatabaseWorker: Veritabanı bağlantısı kapalı," << count << "ölçüm yazılamadı";
+        emit measurementsSaved(count, false);
+        return;
+    }
 
-    // Parametreleri güvenli şekilde bağla
-    if (spo2Min > 0) q.bindValue(":spo2Min", spo2Min);
-    if (spo2Max > 0 && spo2Max <= 100) q.bindValue(":spo2Max", spo2Max);
-    if (prMin > 0) q.bindValue(":prMin", prMin);
-    if (prMax > 0 && prMax <= 300) q.bindValue(":prMax", prMax);
+    QElapsedTimer timer;
+    timer.start();
+
+    // Tüm parti tek transaction: tek WAL commit'i
+    QSqlQuery &q = m_statements->insertMeasurement;
+    QVector<qint64> ids(count);
+    bool ok = m_db.transaction();
+    for (int i = 0; ok && i < count; ++i) {
+        const PendingMeasurement &m = batch.at(i);
+        q.bindValue(0, m.patientId);
+        q.bindValue(1, m.spo2);
+        q.bindValue(2, m.pr);
+        q.bindValue(3, m.timestampMs);
+        ok = q.exec();
+        if (ok)
+            ids[i] = q.lastInsertId().toLongLong();
+    }
+    q.finish();
+    ok = ok && m_db.commit();
 
-    if (!q.exec()) {
-        QString errorMsg = QString("loadFilteredData SQL hatası: %1").arg(q.lastError().text());
-        qWarning() << errorMsg;
+    if (!ok) {
+        const QString reason = q.lastError().isValid() ? q.lastError().text() : m_db.lastError().text();
+        QString errorMsg = QString("%1 ölçüm kaydedilemedi: %2").arg(count).arg(reason);
+        qCritical() << errorMsg;
+        m_db.rollback();
         emit error(errorMsg);
-        emit filteredDataLoaded(QVariantList());
+        emit measurementsSaved(count, false);
         return;
     }
 
-    while (q.next()) {
-        QVariantMap record;
-        record["first_name"] = q.value("first_name");
-        record["last_name"] = q.value("last_name");
-        record["spo2"] = q.value("spo2");
-        record["pr"] = q.value("pr");
-        record["timestamp"] = q.value("formatted_time");
-        list.append(record);
+    // Eklenen satırlar liste sorgusuyla aynı biçimde geri verilir
+    MeasurementBatch rows;
+    rows.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const PendingMeasurement &m = batch.at(i);
+        rows.append(ids.at(i), m.patientId, m.spo2, m.pr, m.timestampMs);
     }
+    m_statements->patientNames.attach(rows);
 
-    qDebug() << "DatabaseWorker: Filtrelenmiş veriler yüklendi, kayıt sayısı:" << list.size();
-    emit filteredDataLoaded(list);
+    qDebug() << "DatabaseWorker:" << count << "ölçüm tek transaction'da kaydedildi (" << timer.elapsed() << "ms)";
+    emit measurementsInserted(rows);
+    emit measurementsSaved(count, true);
 }
 
 void DatabaseWorker::closeDatabase()
 {
-    QMutexLocker locker(&m_mutex);
+    // Kuyrukta kalan ölçümler kapanmadan önce yazılır
+    flushPending();
+
+    // Hazır sorgular bağlantıdan önce bırakılır
+    m_statements.reset();
 
     if (m_db.isOpen()) {
+        // Sorgu planlayıcı istatistikleri gerekiyorsa güncellenir (indeks seçimi)
+        {
+            QSqlQuery optimize(m_db);
+            optimize.exec("PRAGMA optimize");
+        }
+
         m_db.close();
         qDebug() << "DatabaseWorker: Veritabanı bağlantısı kapatıldı";
     }
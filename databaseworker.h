@@ -7,40 +7,91 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
-#include <QVariantList>
-#include <QVariantMap>
-#include <QMutex>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+#include "measurementbatch.h"
 
+// Veritabanının tek yazarı: şema geçişleri, hasta ekleme ve ölçüm kaydı. Okumalar ayrı
+// salt okunur bağlantılarda DatabaseReader ile yapılır; uzun bir tarama kaydı bekletmez.
+// Yalnızca kendi thread'inden kullanılır (slotlar queued, yıkıcı deleteLater ile orada); kilit yok.
+//
+// Ölçüm kaydı kuyruğa alınır ve toplu olarak yazılır: bekleyen satırlar flush aralığı
+// dolduğunda ya da maxBatchSize'a ulaşıldığında tek bir transaction'da eklenir.
+// Veritabanı WAL + synchronous=NORMAL ile açılır (commit başına fsync yok; checkpoint'te).
+// Dayanıklılık sınırı: uygulama çökerse en fazla son flushIntervalMs içindeki kuyruktaki
+// satırlar, güç kesilirse ek olarak son checkpoint'ten sonraki transaction'lar kaybolabilir;
+// veritabanı her durumda tutarlı kalır.
+//
+// Tüm sorgular initializeDatabase'ten sonra bir kez hazırlanır ve bağlantı kapanana
+// kadar yeniden kullanılır.
+// Şema PRAGMA user_version ile sürümlenir; eksik geçişler açılışta yerinde uygulanır.
 class DatabaseWorker : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr int DefaultFlushIntervalMs = 1000;
+    static constexpr int DefaultMaxBatchSize = 256;
+    // Son şema geçişi (PRAGMA user_version); açılışta eksik geçişler sırayla uygulanır
+    static constexpr int SchemaVersion = 3;
+
     explicit DatabaseWorker(QObject *parent = nullptr);
     ~DatabaseWorker();
 
+    int pendingMeasurements() const { return m_pending.size(); }
+
 public slots:
     void initializeDatabase();
     void addPatient(const QString &firstName, const QString &lastName);
+    // Kuyruğa alır; zaman damgası çağrı anındadır (flush anında değil)
     void saveMeasurement(int patientId, int spo2, int pr);
-    void loadAllData();
-    void loadFilteredData(int spo2Min, int spo2Max, int prMin, int prMax);
+    // flushIntervalMs <= 0: her ölçüm hemen kendi transaction'ında yazılır
+    void setIngestPolicy(int flushIntervalMs, int maxBatchSize);
+    // Bekleyen tüm ölçümleri şimdi yazar (kapanışta da çağrılır)
+    void flushMeasurements();
 
 signals:
+    // Şema güncel; okuyucu bağlantıları bundan sonra açılabilir
     void databaseReady();
     void patientAdded(int newPatientId, bool success);
-    void measurementSaved(bool success);
-    void dataLoaded(const QVariantList &data);
-    void filteredDataLoaded(const QVariantList &data);
+    // Her flush için bir kez: count satır tek transaction'da yazıldı (ya da hiçbiri)
+    void measurementsSaved(int count, bool success);
+    // Başarılı flush'ta, measurementsSaved'den önce: eklenen satırlar (id ve zaman damgasıyla,
+    // eklenme sırasıyla). Model bunları tam yeniden yükleme yapmadan ekler.
+    void measurementsInserted(const MeasurementBatch &rows);
     void error(const QString &message);
 
 private:
+    struct PendingMeasurement {
+        int patientId;
+        int spo2;
+        int pr;
+        qint64 timestampMs; // milliseconds since epoch
+    };
+
+    // Bağlantı ömrü boyunca hazır tutulan sorgular
+    struct Statements {
+        explicit Statements(const QSqlDatabase &db);
+        bool prepare();
+
+        QSqlQuery insertPatient;
+        QSqlQuery insertMeasurement;
+        PatientNameCache patientNames; // eklenen satırlara ad/soyad
+    };
+
     QSqlDatabase m_db;
-    QMutex m_mutex;
+    std::unique_ptr<Statements> m_statements;
     QString m_connectionName;
 
-    bool createTables();
+    QVector<PendingMeasurement> m_pending;
+    QTimer *m_flushTimer = nullptr;
+    int m_flushIntervalMs = DefaultFlushIntervalMs;
+    int m_maxBatchSize = DefaultMaxBatchSize;
+
+    bool migrateSchema();
     void closeDatabase();
+    void flushPending(); // zamanlayıcı, flushMeasurements ve kapanış (worker thread'inde)
 };
 
 #endif // DATABASEWORKER_H
@@ -0,0 +1,179 @@
+#include "devicemanager.h"
+#include <QSettings>
+#include <QFileInfo>
+#include <QDebug>
+
+DeviceManager::DeviceManager(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_scheduler(new NotificationScheduler(this))
+{
+}
+
+DeviceManager::~DeviceManager()
+{
+    // Önce Reader'lar (portlarını G/Ç thread'inde kapatır), sonra thread'ler
+    for (const Device &device : std::as_const(m_devices))
+        delete device.reader;
+    m_devices.clear();
+
+    for (QThread *thread : std::as_const(m_ioThreads)) {
+        thread->quit();
+        if (!thread->wait(3000)) {
+            qWarning() << "DeviceManager: G/Ç thread'i sonlandırılamadı, zorla kapatılıyor";
+            thread->terminate();
+            thread->wait(1000);
+        }
+    }
+
+    // Reader'ların son parçaları kuyrukta; kapatma çağrısı onlardan sonra işlenir
+    if (m_store) {
+        QMetaObject::invokeMethod(m_store, &WaveformStore::closeAll, Qt::BlockingQueuedConnection);
+        m_storageThread->quit();
+        m_storageThread->wait();
+        delete m_store;
+    }
+}
+
+int DeviceManager::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return m_devices.count();
+}
+
+QVariant DeviceManager::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_devices.count())
+        return QVariant();
+
+    const Device &device = m_devices.at(index.row());
+
+    switch (role) {
+    case NameRole: return device.name;
+    case PortNameRole: return device.reader->portName();
+    case ReaderRole: return QVariant::fromValue<QObject *>(device.reader);
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> DeviceManager::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(NameRole, "name");
+    roles.insert(PortNameRole, "portName");
+    roles.insert(ReaderRole, "reader");
+    return roles;
+}
+
+bool DeviceManager::loadConfig(const QString &fileName, const QString &defaultPort)
+{
+    QSettings settings(fileName, QSettings::IniFormat);
+
+    startIoThreads(settings.value("ioThreads", 1).toInt());
+    startWaveformStore(settings.value("waveformDirectory", "waveforms").toString(),
+                       settings.value("chunkSeconds", 10.0).toDouble());
+
+    const int size = QFileInfo::exists(fileName) ? settings.beginReadArray("devices") : 0;
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        const QString port = settings.value("port").toString().trimmed();
+        if (port.isEmpty()) {
+            qWarning() << "DeviceManager: port tanımı boş, cihaz atlandı (index" << i << ")";
+            continue;
+        }
+        Reader *reader = addDevice(settings.value("name", port).toString(), port);
+
+        // İsteğe bağlı ham veri kaydı ve "replay:<dizin>" portları için oynatma hızı
+        const QString captureDir = settings.value("capture").toString().trimmed();
+        if (!captureDir.isEmpty())
+            reader->startCapture(captureDir);
+        if (settings.contains("replaySpeed"))
+            reader->setReplaySpeed(settings.value("replaySpeed").toDouble());
+
+        // Pleth filtre zinciri (varsayılan: 6 Hz alçak geçiren)
+        PlethFilterConfig filter;
+        filter.sampleRateHz = settings.value("sampleRateHz", filter.sampleRateHz).toDouble();
+        filter.dcRemoval = settings.value("dcRemoval", filter.dcRemoval).toBool();
+        filter.lowPassHz = settings.value("lowPassHz", filter.lowPassHz).toDouble();
+        filter.notchHz = settings.value("notchHz", filter.notchHz).toDouble();
+        filter.decimation = qMax(1, settings.value("decimation", filter.decimation).toInt());
+        reader->setFilterConfig(filter);
+
+        // Kayan pencere istatistikleri (varsayılan 5 s)
+        if (settings.contains("statsWindowSeconds"))
+            reader->statistics()->setWindowSeconds(settings.value("statsWindowSeconds").toDouble());
+        // Yakınlaştırılabilir geçmiş süresi (varsayılan 60 dk; 24 saat ≈ 7 MB/cihaz)
+        if (settings.contains("historyMinutes"))
+            reader->history()->setHistorySeconds(60.0 * settings.value("historyMinutes").toDouble());
+    }
+    if (size > 0)
+        settings.endArray();
+
+    if (m_devices.isEmpty()) {
+        qDebug() << "DeviceManager:" << fileName << "içinde cihaz yok, varsayılan port kullanılıyor:" << defaultPort;
+        addDevice(defaultPort, defaultPort);
+        return false;
+    }
+
+    qDebug() << "DeviceManager:" << m_devices.size() << "cihaz," << m_ioThreads.size() << "G/Ç thread'i";
+    return true;
+}
+
+Reader *DeviceManager::addDevice(const QString &name, const QString &portName)
+{
+    if (m_ioThreads.isEmpty())
+        startIoThreads(1);
+    if (!m_store)
+        startWaveformStore(QStringLiteral("waveforms"), m_chunkSeconds);
+
+    beginInsertRows(QModelIndex(), m_devices.size(), m_devices.size());
+    Reader *reader = new Reader(portName, nextIoThread(), m_scheduler, this);
+    reader->setWaveformStore(m_store, m_chunkSeconds);
+    m_devices.append({name, reader});
+    endInsertRows();
+
+    emit countChanged();
+    return reader;
+}
+
+Reader *DeviceManager::readerAt(int index) const
+{
+    if (index < 0 || index >= m_devices.size())
+        return nullptr;
+    return m_devices.at(index).reader;
+}
+
+void DeviceManager::startIoThreads(int count)
+{
+    // Havuz yalnızca bir kez kurulur; portlar olay güdümlü olduğundan birkaç thread yeterli
+    if (!m_ioThreads.isEmpty())
+        return;
+
+    count = qBound(1, count, QThread::idealThreadCount());
+    for (int i = 0; i < count; ++i) {
+        QThread *thread = new QThread(this);
+        thread->setObjectName(QStringLiteral("DeviceIO_%1").arg(i));
+        thread->start(QThread::HighPriority);
+        m_ioThreads.append(thread);
+    }
+}
+
+QThread *DeviceManager::nextIoThread()
+{
+    QThread *thread = m_ioThreads.at(m_nextThread);
+    m_nextThread = (m_nextThread + 1) % m_ioThreads.size();
+    return thread;
+}
+
+void DeviceManager::startWaveformStore(const QString &directory, double chunkSeconds)
+{
+    if (m_store)
+        return;
+
+    m_chunkSeconds = qBound(1.0, chunkSeconds, 600.0);
+    m_storageThread = new QThread(this);
+    m_storageThread->setObjectName(QStringLiteral("WaveformStore"));
+    m_store = new WaveformStore(directory);
+    m_store->moveToThread(m_storageThread);
+    m_storageThread->start(QThread::LowPriority);
+    qDebug() << "DeviceManager: waveform arşivi" << directory << "(" << m_chunkSeconds << "s parçalar)";
+}
@@ -0,0 +1,89 @@
+#ifndef DEVICEMANAGER_H
+#define DEVICEMANAGER_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QThread>
+#include "notificationscheduler.h"
+#include "reader.h"
+#include "waveformstore.h"
+
+// Bir süreçte birden çok Biolight modülünü yönetir.
+// Portlar yapılandırma dosyasından okunur; her port kendi çözücü durumu, örnek
+// halkası ve sayısal değerleri olan bir Reader alır. Port başına thread açılmaz:
+// tüm AcquisitionWorker'lar küçük bir G/Ç thread havuzuna (varsayılan 1) dağıtılır
+// ve GUI tarafında tek bir NotificationScheduler paylaşılır.
+class DeviceManager : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        PortNameRole,
+        ReaderRole
+    };
+
+    explicit DeviceManager(QObject *parent = nullptr);
+    ~DeviceManager() override;
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // INI dosyası biçimi:
+    //   [General]
+    //   ioThreads=1
+    //   waveformDirectory=waveforms (uzun süreli waveform arşivi)
+    //   chunkSeconds=10           (arşiv parçası süresi)
+    //   [devices]
+    //   size=2
+    //   1\name=Yatak 1
+    //   1\port=COM8
+    //   1\capture=captures        (isteğe bağlı ham veri kaydı dizini)
+    //   1\lowPassHz=6             (pleth filtresi; ayrıca notchHz, dcRemoval, decimation, sampleRateHz)
+    //   1\statsWindowSeconds=5    (p-p / σ / PI tahmini penceresi)
+    //   1\historyMinutes=60       (yakınlaştırılabilir geçmiş)
+    //   2\port=replay:captures/COM8_20250101_120000
+    //   2\replaySpeed=4           (1 = gerçek zaman, 0 = azami hız)
+    //   [Database]                (main.cpp okur; ölçüm kaydı, bkz. DatabaseWorker)
+    //   flushIntervalMs=1000      (kuyruktaki satırın en uzun bekleme süresi)
+    //   maxBatchSize=256          (transaction başına en fazla satır)
+    // Dosya yoksa ya da cihaz tanımlı değilse defaultPort ile tek cihaz açılır.
+    bool loadConfig(const QString &fileName, const QString &defaultPort);
+
+    Reader *addDevice(const QString &name, const QString &portName);
+
+    int count() const { return m_devices.size(); }
+    Q_INVOKABLE Reader *readerAt(int index) const;
+
+    NotificationScheduler *scheduler() const { return m_scheduler; }
+    // Tüm cihazların paylaştığı waveform arşivi (kendi depolama thread'inde yazar)
+    WaveformStore *waveformStore() const { return m_store; }
+
+signals:
+    void countChanged();
+
+private:
+    struct Device {
+        QString name;
+        Reader *reader;
+    };
+
+    void startIoThreads(int count);
+    QThread *nextIoThread();
+    void startWaveformStore(const QString &directory, double chunkSeconds);
+
+    NotificationScheduler *m_scheduler;
+    QList<QThread *> m_ioThreads;
+    int m_nextThread = 0;
+    QList<Device> m_devices;
+
+    QThread *m_storageThread = nullptr;
+    WaveformStore *m_store = nullptr;
+    double m_chunkSeconds = 10.0;
+};
+
+#endif // DEVICEMANAGER_H
@@ -0,0 +1,118 @@
+#include "dspfilter.h"
+#include <cmath>
+
+namespace Dsp {
+
+float dot(const float *a, const float *b, int n)
+{
+    int i = 0;
+#if defined(DSP_SIMD_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    // Yatay toplama (SSE2)
+    __m128 shuffled = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1));
+    acc = _mm_add_ps(acc, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, acc);
+    acc = _mm_add_ss(acc, shuffled);
+    float sum = _mm_cvtss_f32(acc);
+#elif defined(DSP_SIMD_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4)
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#else
+    float sum = 0.0f;
+#endif
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+void designLowPassFir(float *coefficients, int taps, double normalizedCutoff)
+{
+    const double center = (taps - 1) / 2.0;
+    double total = 0.0;
+    for (int k = 0; k < taps; ++k) {
+        const double t = k - center;
+        const double sinc = t == 0.0 ? 2.0 * normalizedCutoff
+                                     : std::sin(2.0 * M_PI * normalizedCutoff * t) / (M_PI * t);
+        const double window = taps > 1 ? 0.54 - 0.46 * std::cos(2.0 * M_PI * k / (taps - 1)) : 1.0;
+        coefficients[k] = static_cast<float>(sinc * window);
+        total += coefficients[k];
+    }
+    // Birim DC kazancı: pleth seviyesi korunur
+    for (int k = 0; k < taps; ++k)
+        coefficients[k] = static_cast<float>(coefficients[k] / total);
+}
+
+BiquadCoefficients BiquadCoefficients::lowPass(double sampleRateHz, double cutoffHz, double q)
+{
+    if (sampleRateHz <= 0.0 || cutoffHz <= 0.0 || cutoffHz >= sampleRateHz / 2.0 || q <= 0.0)
+        return identity();
+
+    const double w0 = 2.0 * M_PI * cutoffHz / sampleRateHz;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double cosw = std::cos(w0);
+    const double a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = static_cast<float>((1.0 - cosw) / 2.0 / a0);
+    c.b1 = static_cast<float>((1.0 - cosw) / a0);
+    c.b2 = c.b0;
+    c.a1 = static_cast<float>(-2.0 * cosw / a0);
+    c.a2 = static_cast<float>((1.0 - alpha) / a0);
+    return c;
+}
+
+BiquadCoefficients BiquadCoefficients::notch(double sampleRateHz, double centerHz, double q)
+{
+    if (sampleRateHz <= 0.0 || centerHz <= 0.0 || centerHz >= sampleRateHz / 2.0 || q <= 0.0)
+        return identity();
+
+    const double w0 = 2.0 * M_PI * centerHz / sampleRateHz;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double cosw = std::cos(w0);
+    const double a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = static_cast<float>(1.0 / a0);
+    c.b1 = static_cast<float>(-2.0 * cosw / a0);
+    c.b2 = c.b0;
+    c.a1 = c.b1;
+    c.a2 = static_cast<float>((1.0 - alpha) / a0);
+    return c;
+}
+
+} // namespace Dsp
+
+int PlethFilterBank::process(float *const beds[Lanes], int count)
+{
+    int produced = 0;
+    for (int start = 0; start < count; start += BlockSize) {
+        const int block = qMin(BlockSize, count - start);
+
+        // Düzlemsel -> şerit düzeni (her zaman adımı bir Lanes4)
+        for (int i = 0; i < block; ++i) {
+            float lanes[Lanes];
+            for (int lane = 0; lane < Lanes; ++lane)
+                lanes[lane] = beds[lane] ? beds[lane][start + i] : 0.0f;
+            m_block[i] = Lanes4::load(lanes);
+        }
+
+        const int out = m_chain.process(m_block, block);
+
+        // Çıkış yerinde geri yazılır; decimation ile çıkış indeksi girişin gerisinde kalır
+        for (int i = 0; i < out; ++i) {
+            float lanes[Lanes];
+            m_block[i].store(lanes);
+            for (int lane = 0; lane < Lanes; ++lane) {
+                if (beds[lane])
+                    beds[lane][produced + i] = lanes[lane];
+            }
+        }
+        produced += out;
+    }
+    return produced;
+}
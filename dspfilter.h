@@ -0,0 +1,391 @@
+#ifndef DSPFILTER_H
+#define DSPFILTER_H
+
+#include <QtGlobal>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DSP_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DSP_SIMD_NEON 1
+#endif
+
+// Pleth waveform'u için akış tabanlı filtre zinciri.
+//
+// Aşamalar (DcBlocker, Biquad, FirFilter, Decimator) örnek tipi T üzerinden
+// şablondur: T = float tek bir cihazı, T = Lanes4 aynı anda dört cihazı (yatağı)
+// işler. IIR filtreler doğası gereği örnekten örneğe seri olduğundan SIMD
+// cihazlar boyunca uygulanır; FIR çekirdeği tek cihazda katsayılar boyunca
+// SIMD nokta çarpımı kullanır. Tüm durum aşama nesnelerinde tutulur ve bloklar
+// yerinde (in-place) işlenir; işleme sırasında heap ayırması yapılmaz.
+
+// --- Dört şeritli float vektör (SSE2 / NEON / skaler) ---
+struct Lanes4 {
+#if defined(DSP_SIMD_SSE2)
+    __m128 v;
+    Lanes4() : v(_mm_setzero_ps()) {}
+    explicit Lanes4(float s) : v(_mm_set1_ps(s)) {}
+    explicit Lanes4(__m128 x) : v(x) {}
+    static Lanes4 load(const float *p) { return Lanes4(_mm_loadu_ps(p)); }
+    void store(float *p) const { _mm_storeu_ps(p, v); }
+    friend Lanes4 operator+(Lanes4 a, Lanes4 b) { return Lanes4(_mm_add_ps(a.v, b.v)); }
+    friend Lanes4 operator-(Lanes4 a, Lanes4 b) { return Lanes4(_mm_sub_ps(a.v, b.v)); }
+    friend Lanes4 operator*(Lanes4 a, Lanes4 b) { return Lanes4(_mm_mul_ps(a.v, b.v)); }
+    friend Lanes4 operator*(float s, Lanes4 a) { return Lanes4(_mm_mul_ps(_mm_set1_ps(s), a.v)); }
+#elif defined(DSP_SIMD_NEON)
+    float32x4_t v;
+    Lanes4() : v(vdupq_n_f32(0.0f)) {}
+    explicit Lanes4(float s) : v(vdupq_n_f32(s)) {}
+    explicit Lanes4(float32x4_t x) : v(x) {}
+    static Lanes4 load(const float *p) { return Lanes4(vld1q_f32(p)); }
+    void store(float *p) const { vst1q_f32(p, v); }
+    friend Lanes4 operator+(Lanes4 a, Lanes4 b) { return Lanes4(vaddq_f32(a.v, b.v)); }
+    friend Lanes4 operator-(Lanes4 a, Lanes4 b) { return Lanes4(vsubq_f32(a.v, b.v)); }
+    friend Lanes4 operator*(Lanes4 a, Lanes4 b) { return Lanes4(vmulq_f32(a.v, b.v)); }
+    friend Lanes4 operator*(float s, Lanes4 a) { return Lanes4(vmulq_n_f32(a.v, s)); }
+#else
+    float v[4];
+    Lanes4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+    explicit Lanes4(float s) : v{s, s, s, s} {}
+    static Lanes4 load(const float *p) { Lanes4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+    void store(float *p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+    friend Lanes4 operator+(Lanes4 a, Lanes4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    friend Lanes4 operator-(Lanes4 a, Lanes4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    friend Lanes4 operator*(Lanes4 a, Lanes4 b) { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    friend Lanes4 operator*(float s, Lanes4 a) { for (int i = 0; i < 4; ++i) a.v[i] *= s; return a; }
+#endif
+    static constexpr int Width = 4;
+};
+
+namespace Dsp {
+
+template <typename T> inline T splat(float s) { return T(s); }
+
+// Tek kanallı FIR için SIMD nokta çarpımı (dspfilter.cpp)
+float dot(const float *a, const float *b, int n);
+
+// --- DC giderici: y[n] = x[n] - x[n-1] + R * y[n-1] ---
+template <typename T>
+class DcBlocker
+{
+public:
+    void configure(bool enabled, double sampleRateHz, double cutoffHz);
+    void reset() { m_x1 = T(); m_y1 = T(); m_primed = false; }
+
+    int process(T *data, int count)
+    {
+        if (!m_enabled)
+            return count;
+        if (!m_primed && count > 0) {
+            // İlk örnekten başla: açılışta büyük bir sıçrama olmasın
+            m_x1 = data[0];
+            m_primed = true;
+        }
+        for (int i = 0; i < count; ++i) {
+            const T x = data[i];
+            const T y = x - m_x1 + m_r * m_y1;
+            m_x1 = x;
+            m_y1 = y;
+            data[i] = y;
+        }
+        return count;
+    }
+
+private:
+    bool m_enabled = false;
+    bool m_primed = false;
+    float m_r = 0.995f;
+    T m_x1 = T();
+    T m_y1 = T();
+};
+
+// --- İkinci dereceden IIR (transposed direct form II) ---
+struct BiquadCoefficients {
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+    bool isIdentity() const { return b0 == 1.0f && b1 == 0.0f && b2 == 0.0f && a1 == 0.0f && a2 == 0.0f; }
+
+    // RBJ "Audio EQ Cookbook" tasarımları; geçersiz frekansta birim filtre döner
+    static BiquadCoefficients identity() { return BiquadCoefficients(); }
+    static BiquadCoefficients lowPass(double sampleRateHz, double cutoffHz, double q = 0.7071);
+    static BiquadCoefficients notch(double sampleRateHz, double centerHz, double q = 10.0);
+};
+
+template <typename T>
+class Biquad
+{
+public:
+    void configure(const BiquadCoefficients &c) { m_c = c; m_enabled = !c.isIdentity(); }
+    void reset() { m_z1 = T(); m_z2 = T(); m_primed = false; }
+
+    int process(T *data, int count)
+    {
+        if (!m_enabled)
+            return count;
+        if (!m_primed && count > 0) {
+            // Durumu ilk örneğin kararlı haline getir (DC kazancı ile)
+            prime(data[0]);
+            m_primed = true;
+        }
+        for (int i = 0; i < count; ++i) {
+            const T x = data[i];
+            const T y = m_c.b0 * x + m_z1;
+            m_z1 = m_c.b1 * x - m_c.a1 * y + m_z2;
+            m_z2 = m_c.b2 * x - m_c.a2 * y;
+            data[i] = y;
+        }
+        return count;
+    }
+
+private:
+    void prime(const T &x)
+    {
+        const float denominator = 1.0f + m_c.a1 + m_c.a2;
+        const float gain = denominator != 0.0f ? (m_c.b0 + m_c.b1 + m_c.b2) / denominator : 0.0f;
+        const T y = gain * x;
+        m_z2 = m_c.b2 * x - m_c.a2 * y;
+        m_z1 = m_c.b1 * x - m_c.a1 * y + m_z2;
+    }
+
+    BiquadCoefficients m_c;
+    bool m_enabled = false;
+    bool m_primed = false;
+    T m_z1 = T();
+    T m_z2 = T();
+};
+
+// --- Sabit uzunluklu FIR (decimation öncesi örtüşme önleyici) ---
+// Geçmiş aynalanmış tutulur (i ve i + Taps), böylece pencere her zaman bitişiktir.
+template <typename T, int Taps>
+class FirFilter
+{
+public:
+    static_assert(Taps >= 1, "FIR en az bir katsayı içermeli");
+
+    // cutoff: örnekleme hızına oranla (0 < cutoff < 0.5); <= 0 ise kapalı
+    void configure(double normalizedCutoff);
+    void reset()
+    {
+        m_history.fill(T());
+        m_pos = 0;
+        m_primed = false;
+    }
+
+    int process(T *data, int count)
+    {
+        if (!m_enabled)
+            return count;
+        if (!m_primed && count > 0) {
+            m_history.fill(data[0]);
+            m_primed = true;
+        }
+        for (int i = 0; i < count; ++i) {
+            m_history[m_pos] = data[i];
+            m_history[m_pos + Taps] = data[i];
+            m_pos = (m_pos + 1) % Taps;
+            // m_history[m_pos .. m_pos+Taps): en eskiden en yeniye
+            data[i] = apply(&m_history[m_pos]);
+        }
+        return count;
+    }
+
+private:
+    T apply(const T *window) const
+    {
+        if constexpr (std::is_same_v<T, float>) {
+            return dot(m_coefficients.data(), window, Taps);
+        } else {
+            T sum = T();
+            for (int k = 0; k < Taps; ++k)
+                sum = sum + m_coefficients[k] * window[k];
+            return sum;
+        }
+    }
+
+    bool m_enabled = false;
+    bool m_primed = false;
+    std::array<float, Taps> m_coefficients{}; // en eski örneğe uygulanan ilk sırada
+    std::array<T, 2 * Taps> m_history{};
+    int m_pos = 0;
+};
+
+// Tasarım yardımcısı (Hamming pencereli sinc, birim DC kazancı)
+void designLowPassFir(float *coefficients, int taps, double normalizedCutoff);
+
+template <typename T, int Taps>
+void FirFilter<T, Taps>::configure(double normalizedCutoff)
+{
+    m_enabled = normalizedCutoff > 0.0 && normalizedCutoff < 0.5;
+    if (m_enabled)
+        designLowPassFir(m_coefficients.data(), Taps, normalizedCutoff);
+    reset();
+}
+
+// --- Decimation: her factor örnekten birini tutar, blok sıkıştırılır ---
+template <typename T>
+class Decimator
+{
+public:
+    void configure(int factor) { m_factor = qMax(1, factor); reset(); }
+    void reset() { m_counter = 0; }
+    int factor() const { return m_factor; }
+
+    // kept (isteğe bağlı): hangi giriş örneğinin çıkış ürettiğini işaretler
+    int process(T *data, int count, quint8 *kept = nullptr)
+    {
+        if (m_factor == 1) {
+            if (kept)
+                std::fill(kept, kept + count, quint8(1));
+            return count;
+        }
+        int out = 0;
+        for (int i = 0; i < count; ++i) {
+            const bool keep = ++m_counter == m_factor;
+            if (keep) {
+                m_counter = 0;
+                data[out++] = data[i];
+            }
+            if (kept)
+                kept[i] = keep;
+        }
+        return out;
+    }
+
+private:
+    int m_factor = 1;
+    int m_counter = 0;
+};
+
+template <typename T>
+void DcBlocker<T>::configure(bool enabled, double sampleRateHz, double cutoffHz)
+{
+    m_enabled = enabled && sampleRateHz > 0.0 && cutoffHz > 0.0;
+    if (m_enabled)
+        m_r = static_cast<float>(qBound(0.0, 1.0 - 2.0 * M_PI * cutoffHz / sampleRateHz, 0.99999));
+    reset();
+}
+
+// --- Aşamaların derleme zamanında birleştirilmesi ---
+template <typename T, typename... Stages>
+class FilterChain
+{
+public:
+    template <size_t I>
+    auto &stage() { return std::get<I>(m_stages); }
+
+    void reset() { std::apply([](auto &...s) { (s.reset(), ...); }, m_stages); }
+
+    int process(T *data, int count)
+    {
+        std::apply([&](auto &...s) { ((count = s.process(data, count)), ...); }, m_stages);
+        return count;
+    }
+
+private:
+    std::tuple<Stages...> m_stages;
+};
+
+} // namespace Dsp
+
+// Cihaz başına pleth filtre yapılandırması (devices.ini'den okunur)
+struct PlethFilterConfig {
+    double sampleRateHz = 50.0;  // modülün pleth hızı
+    bool dcRemoval = false;      // açıkken çıkış 0-255 ekran ölçeğine geri ötelenir
+    double dcCutoffHz = 0.05;
+    double lowPassHz = 6.0;      // <= 0: kapalı
+    double notchHz = 0.0;        // şebeke/ortam ışığı girişimi; <= 0: kapalı
+    double notchQ = 10.0;
+    int decimation = 1;          // > 1 ise örtüşme önleyici FIR devreye girer
+
+    double outputRateHz() const { return sampleRateHz / qMax(1, decimation); }
+};
+
+// Sabit pleth zinciri: DC giderme -> alçak geçiren IIR -> çentik -> FIR -> decimation.
+// T = float tek cihaz (PlethFilter), T = Lanes4 dört cihaz (PlethFilterBank).
+template <typename T>
+class PlethChain
+{
+public:
+    static constexpr int FirTaps = 15;
+    static constexpr float DisplayOffset = 128.0f; // DC giderildiğinde 0-255 ölçeğinin ortası
+
+    explicit PlethChain(const PlethFilterConfig &config = PlethFilterConfig()) { configure(config); }
+
+    void configure(const PlethFilterConfig &config)
+    {
+        m_config = config;
+        const double fs = config.sampleRateHz;
+        m_chain.template stage<0>().configure(config.dcRemoval, fs, config.dcCutoffHz);
+        m_chain.template stage<1>().configure(config.lowPassHz > 0.0
+            ? Dsp::BiquadCoefficients::lowPass(fs, config.lowPassHz) : Dsp::BiquadCoefficients::identity());
+        m_chain.template stage<2>().configure(config.notchHz > 0.0
+            ? Dsp::BiquadCoefficients::notch(fs, config.notchHz, config.notchQ) : Dsp::BiquadCoefficients::identity());
+        // Yeni Nyquist'in %80'i
+        m_chain.template stage<3>().configure(config.decimation > 1 ? 0.8 * 0.5 / config.decimation : 0.0);
+        m_decimator.configure(config.decimation);
+        m_offset = config.dcRemoval ? DisplayOffset : 0.0f;
+    }
+
+    const PlethFilterConfig &config() const { return m_config; }
+
+    void reset()
+    {
+        m_chain.reset();
+        m_decimator.reset();
+    }
+
+    // Bloğu yerinde filtreler; çıkış örnek sayısını döndürür (decimation ile azalır)
+    int process(T *data, int count, quint8 *kept = nullptr)
+    {
+        count = m_chain.process(data, count);
+        count = m_decimator.process(data, count, kept);
+        if (m_offset != 0.0f) {
+            const T offset = Dsp::splat<T>(m_offset);
+            for (int i = 0; i < count; ++i)
+                data[i] = data[i] + offset;
+        }
+        return count;
+    }
+
+private:
+    Dsp::FilterChain<T,
+                     Dsp::DcBlocker<T>,
+                     Dsp::Biquad<T>,
+                     Dsp::Biquad<T>,
+                     Dsp::FirFilter<T, FirTaps>> m_chain;
+    Dsp::Decimator<T> m_decimator;
+    PlethFilterConfig m_config;
+    float m_offset = 0.0f;
+};
+
+using PlethFilter = PlethChain<float>;
+
+// Dört cihazı tek geçişte filtreler (şerit başına bir yatak). Daha fazla yatak için
+// ceil(n / 4) banka kullanılır. Tüm şeritler aynı yapılandırmayı ve örnek hızını paylaşır.
+class PlethFilterBank
+{
+public:
+    static constexpr int Lanes = Lanes4::Width;
+    static constexpr int BlockSize = 64;
+
+    explicit PlethFilterBank(const PlethFilterConfig &config = PlethFilterConfig()) : m_chain(config) {}
+
+    void configure(const PlethFilterConfig &config) { m_chain.configure(config); }
+    void reset() { m_chain.reset(); }
+
+    // beds[lane]: her yatak için count örneklik düzlemsel tampon (nullptr şerit sıfırla beslenir).
+    // Sonuç aynı tamponlara yazılır; çıkış örnek sayısını döndürür.
+    int process(float *const beds[Lanes], int count);
+
+private:
+    PlethChain<Lanes4> m_chain;
+    Lanes4 m_block[BlockSize];
+};
+
+#endif // DSPFILTER_H
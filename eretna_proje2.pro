@@ -4,18 +4,49 @@ QT += core serialport sql quick qml quickcontrols2 charts printsupport
 CONFIG += console c++17 qml_debug
 
 SOURCES += main.cpp \
+    acquisitionworker.cpp \
+    capturefile.cpp \
     databasemanager.cpp \
+    databasereader.cpp \
     databaseworker.cpp \
+    devicemanager.cpp \
+    dspfilter.cpp \
     measurementlistmodel.cpp \
+    notificationscheduler.cpp \
+    packetframer.cpp \
     reader.cpp \
-    pdfexporter.cpp
+    pdfexporter.cpp \
+    waveformcodec.cpp \
+    waveformhistory.cpp \
+    waveformitem.cpp \
+    waveformmodel.cpp \
+    waveformstatistics.cpp \
+    waveformstore.cpp
 
 HEADERS += \
+    acquisitionworker.h \
+    biolightprotocol.h \
+    capturefile.h \
     databasemanager.h \
+    databasereader.h \
     databaseworker.h \
+    measurementbatch.h \
+    devicemanager.h \
+    dspfilter.h \
     measurementlistmodel.h \
+    notificationscheduler.h \
+    packetframer.h \
     reader.h \
-    pdfexporter.h
+    samplering.h \
+    spscqueue.h \
+    pdfexporter.h \
+    waveformcodec.h \
+    waveformhistory.h \
+    waveformitem.h \
+    waveformmodel.h \
+    waveformpyramid.h \
+    waveformstatistics.h \
+    waveformstore.h
 
 DISTFILES += \
     main.qml
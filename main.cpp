@@ -1,12 +1,16 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
+#include <QSettings>
 #include <QTimer>
 #include <QDebug>
 #include "reader.h"
+#include "devicemanager.h"
 #include "databasemanager.h"
 #include "measurementlistmodel.h"
 #include "pdfexporter.h"
+#include "waveformitem.h"
 
 int main(int argc, char *argv[]) {
     QGuiApplication app(argc, argv);
@@ -14,14 +18,34 @@ int main(int argc, char *argv[]) {
     qDebug() << "UI Thread ID (main thread):" << QThread::currentThreadId();
 
 
+    // Scene graph tabanlı waveform çizicisi
+    qmlRegisterType<WaveformItem>("SpO2Monitor", 1, 0, "WaveformTrace");
+    // Min/max piramidinden çizilen yakınlaştırılabilir geçmiş
+    qmlRegisterType<WaveformHistoryItem>("SpO2Monitor", 1, 0, "WaveformHistoryTrace");
+
     QQmlApplicationEngine engine;    
 
     // Model oluştur
     MeasurementListModel model;
     engine.rootContext()->setContextProperty("measurementModel", &model);
 
-    // Reader heap üzerinde oluşturuluyor; app parent olarak veriliyor ki yaşam süresi boyunca canlı kalsın
-    Reader *r = new Reader("COM8", &app);
+    // Ölçümler toplu yazılır; sınırlar devices.ini [Database] grubundan
+    {
+        QSettings settings(QStringLiteral("devices.ini"), QSettings::IniFormat);
+        settings.beginGroup("Database");
+        model.databaseManager()->setIngestPolicy(
+            settings.value("flushIntervalMs", DatabaseWorker::DefaultFlushIntervalMs).toInt(),
+            settings.value("maxBatchSize", DatabaseWorker::DefaultMaxBatchSize).toInt());
+    }
+
+    // Cihazlar devices.ini'den okunur (yoksa tek cihaz: COM8); app parent olarak veriliyor
+    // ki yaşam süresi boyunca canlı kalsın. Tüm portlar ortak G/Ç thread'ini paylaşır.
+    DeviceManager *devices = new DeviceManager(&app);
+    devices->loadConfig(QStringLiteral("devices.ini"), QStringLiteral("COM8"));
+    engine.rootContext()->setContextProperty("deviceModel", devices);
+
+    // Ana sayfa ilk cihazı gösterir
+    Reader *r = devices->readerAt(0);
     engine.rootContext()->setContextProperty("reader", r);
 
     // PDF Exporter oluştur
@@ -35,6 +59,8 @@ int main(int argc, char *argv[]) {
 
     // Eğer aktif hasta varsa timer başlat, aksi halde durdur
     QObject::connect(&model, &MeasurementListModel::activePatientChanged, [&](bool ready) {
+        // Ana sayfadaki cihazın waveform'u aktif hastanın arşivine yazılır
+        r->setPatientId(ready ? model.currentPatientId() : -1);
         if (ready) {
             if (!saveTimer->isActive()) {
                 saveTimer->start();
@@ -74,5 +100,9 @@ int main(int argc, char *argv[]) {
     if (engine.rootObjects().isEmpty())
         return -1;
 
+    // Reader bildirimlerini pencerenin kare döngüsüne hizala (gizliyken çizim durur)
+    if (QQuickWindow *window = qobject_cast<QQuickWindow *>(engine.rootObjects().first()))
+        devices->scheduler()->attachWindow(window);
+
     return app.exec();
 }
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import SpO2Monitor 1.0
 
 ApplicationWindow {
     id: appWindow
@@ -126,6 +127,29 @@ ApplicationWindow {
                             }
                         }
                     }
+
+                    Column {
+                        spacing: 6
+                        Text { text: reader.perfusionIndex < 0 ? "PI: -" : "PI: " + reader.perfusionIndex.toFixed(2) + " %" }
+                        // Son pencere üzerinden hesaplanan waveform istatistikleri (ham ölçek)
+                        Text {
+                            text: reader.statistics.sampleCount === 0 ? "p-p: -"
+                                  : "p-p: " + reader.statistics.peakToPeak.toFixed(0)
+                                    + "  σ: " + reader.statistics.standardDeviation.toFixed(1)
+                            color: "gray"
+                        }
+                        Text {
+                            text: reader.statistics.sampleCount === 0 ? "PI~: -"
+                                  : "PI~: " + reader.statistics.perfusionIndex.toFixed(1) + " %"
+                            color: "gray"
+                        }
+                        Text {
+                            text: "⚠ Prob takılı değil"
+                            color: "red"
+                            font.bold: true
+                            visible: reader.probeOff
+                        }
+                    }
                 }
 
                 // WAVEFORM
@@ -137,79 +161,17 @@ ApplicationWindow {
                     border.color: "black"
                     border.width: 2
 
-                    Canvas {
-                        id: waveformCanvas
+                    // Scene graph ile çizilen süpürmeli iz (yalnızca yeni segmentler güncellenir)
+                    WaveformTrace {
+                        id: waveformTrace
                         anchors.fill: parent
                         anchors.margins: 10
-
-                        onPaint: {
-                            var ctx = getContext("2d")
-                            ctx.clearRect(0, 0, width, height)
-
-                            drawGrid(ctx)
-                            drawWaveform(ctx)
-                        }
-
-                        function drawGrid(ctx) {
-                            ctx.strokeStyle = "#D3D3D3"
-                            ctx.lineWidth = 0.5
-
-                            var gridSpacingY = height / 8
-                            for (var i = 1; i < 8; i++) {
-                                ctx.beginPath()
-                                ctx.moveTo(0, i * gridSpacingY)
-                                ctx.lineTo(width, i * gridSpacingY)
-                                ctx.stroke()
-                            }
-
-                            var gridSpacingX = width / 10
-                            for (var i = 1; i < 10; i++) {
-                                ctx.beginPath()
-                                ctx.moveTo(i * gridSpacingX, 0)
-                                ctx.lineTo(i * gridSpacingX, height)
-                                ctx.stroke()
-                            }
-                        }
-
-                        function drawWaveform(ctx) {
-                            if (!reader.waveform || reader.waveform.length === 0) return
-
-                            ctx.strokeStyle = "#006400"
-                            ctx.lineWidth = 2
-                            ctx.lineCap = "round"
-                            ctx.lineJoin = "round"
-
-                            ctx.beginPath()
-
-                            var dataPoints = reader.waveform
-                            var step = width / Math.max((dataPoints.length - 1), 1)
-
-                            var y0 = height - (dataPoints[0] / 255.0 * height)
-                            ctx.moveTo(0, y0)
-
-                            for (var i = 1; i < dataPoints.length; i++) {
-                                var x = i * step
-                                var y = height - (dataPoints[i] / 255.0 * height)
-                                var prevX = (i-1) * step
-                                var prevY = height - (dataPoints[i-1] / 255.0 * height)
-
-                                var cpX1 = prevX + step * 0.3
-                                var cpY1 = prevY
-                                var cpX2 = x - step * 0.3
-                                var cpY2 = y
-
-                                ctx.bezierCurveTo(cpX1, cpY1, cpX2, cpY2, x, y)
-                            }
-
-                            ctx.stroke()
-                        }
-
-                        Connections {
-                            target: reader
-                            function onWaveformChanged() {
-                                if (!reader.frozen) waveformCanvas.requestPaint()
-                            }
-                        }
+                        clip: true
+                        model: reader.waveformModel
+                        lineColor: "#006400"
+                        gridColor: "#D3D3D3"
+                        backgroundColor: parent.color
+                        lineWidth: 2
                     }
 
                     Row {
@@ -233,6 +195,50 @@ ApplicationWindow {
                     }
                 }
 
+                // GEÇMİŞ: min/max zarfı, piksel sütunu başına bir segment
+                Item { width: 1; height: 15 }
+                Row {
+                    spacing: 6
+                    Text { text: "Geçmiş:"; font.pixelSize: 16; anchors.verticalCenter: parent.verticalCenter }
+                    Repeater {
+                        model: [
+                            { label: "10 s", seconds: 10 },
+                            { label: "1 dk", seconds: 60 },
+                            { label: "10 dk", seconds: 600 },
+                            { label: "1 sa", seconds: 3600 }
+                        ]
+                        Button {
+                            text: modelData.label
+                            highlighted: historyTrace.spanSeconds === modelData.seconds
+                            onClicked: historyTrace.spanSeconds = modelData.seconds
+                        }
+                    }
+                    Text {
+                        anchors.verticalCenter: parent.verticalCenter
+                        text: "(" + Math.floor(reader.history.availableSeconds / 60) + " dk kayıtlı)"
+                        font.pixelSize: 11
+                        color: "#666666"
+                    }
+                }
+
+                Rectangle {
+                    width: 520; height: 110
+                    color: "#F5F5DC"
+                    border.color: "black"
+                    border.width: 1
+
+                    WaveformHistoryTrace {
+                        id: historyTrace
+                        anchors.fill: parent
+                        anchors.margins: 6
+                        clip: true
+                        history: reader.history
+                        spanSeconds: 60
+                        lineColor: "#006400"
+                        gridColor: "#D3D3D3"
+                    }
+                }
+
                 // EK BOŞLUK - PDF butonu için daha fazla boşluk
                 Item {
                     width: 1
@@ -247,7 +253,7 @@ ApplicationWindow {
                     onClicked: {
                         var patientName = measurementModel.getLastPatientName()
                         var success = pdfExporter.exportWaveformToPdf(
-                            waveformCanvas,
+                            waveformTrace,
                             patientName,
                             reader.spo2,
                             reader.pr
@@ -406,6 +412,9 @@ ApplicationWindow {
                     height: parent.height-280
                     model: measurementModel
                     clip:true
+                    // Görünür alanın bu kadar ötesine kadar delegate hazırlanır; son satıra
+                    // ulaşılınca model fetchMore ile sonraki sayfayı ister
+                    cacheBuffer: 1000
 
                     delegate: Row {
                         spacing: 80
@@ -0,0 +1,151 @@
+#ifndef MEASUREMENTBATCH_H
+#define MEASUREMENTBATCH_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMetaType>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+struct PatientName {
+    QString firstName;
+    QString lastName;
+};
+
+// Ölçüm satırları sütun dizileri olarak: satır başına ~23 bayt (id, zaman, hasta id,
+// SpO2, PR); hasta adları satırlarda tekrarlanmaz, patients tablosunda bir kez tutulur.
+// Worker ile GUI thread'i arasında kayıtlı metatype olarak (değerle, paylaşımlı dizilerle) taşınır.
+struct MeasurementBatch {
+    // Ölçüm sorgularının SELECT sırası (m.id, m.patient_id, m.spo2, m.pr, m.timestamp_ms)
+    enum Column {
+        IdColumn = 0,
+        PatientIdColumn,
+        Spo2Column,
+        PrColumn,
+        TimestampColumn
+    };
+
+    QVector<qint64> ids;
+    QVector<qint64> timestampsMs;   // milliseconds since epoch
+    QVector<qint32> patientIds;
+    QVector<quint8> spo2;
+    QVector<quint16> pr;
+    QHash<qint32, PatientName> patients; // bu satırlardaki hastalar
+
+    int size() const { return ids.size(); }
+    bool isEmpty() const { return ids.isEmpty(); }
+
+    void reserve(int count)
+    {
+        ids.reserve(count);
+        timestampsMs.reserve(count);
+        patientIds.reserve(count);
+        spo2.reserve(count);
+        pr.reserve(count);
+    }
+
+    void append(qint64 id, qint32 patientId, int spo2Value, int prValue, qint64 timestampMs)
+    {
+        ids.append(id);
+        timestampsMs.append(timestampMs);
+        patientIds.append(patientId);
+        spo2.append(static_cast<quint8>(qBound(0, spo2Value, 255)));
+        pr.append(static_cast<quint16>(qBound(0, prValue, 65535)));
+    }
+
+    // Sütunlar indeksle okunur (ad ile q.value("...") araması yok)
+    void appendFromQuery(const QSqlQuery &q)
+    {
+        append(q.value(IdColumn).toLongLong(), q.value(PatientIdColumn).toInt(),
+               q.value(Spo2Column).toInt(), q.value(PrColumn).toInt(), q.value(TimestampColumn).toLongLong());
+    }
+
+    void removeLast()
+    {
+        ids.removeLast();
+        timestampsMs.removeLast();
+        patientIds.removeLast();
+        spo2.removeLast();
+        pr.removeLast();
+    }
+
+    // other'ın i. satırını sona/başa kopyalar (hasta adı da taşınır)
+    void appendRow(const MeasurementBatch &other, int i)
+    {
+        append(other.ids.at(i), other.patientIds.at(i), other.spo2.at(i), other.pr.at(i), other.timestampsMs.at(i));
+        internPatient(other, other.patientIds.at(i));
+    }
+
+    void prependRow(const MeasurementBatch &other, int i)
+    {
+        ids.prepend(other.ids.at(i));
+        timestampsMs.prepend(other.timestampsMs.at(i));
+        patientIds.prepend(other.patientIds.at(i));
+        spo2.prepend(other.spo2.at(i));
+        pr.prepend(other.pr.at(i));
+        internPatient(other, other.patientIds.at(i));
+    }
+
+    PatientName patient(int i) const { return patients.value(patientIds.at(i)); }
+
+    // Listede gösterilen biçim (yerel saat)
+    QString formattedTimestamp(int i) const
+    {
+        return QDateTime::fromMSecsSinceEpoch(timestampsMs.at(i)).toString("yyyy-MM-dd HH:mm:ss");
+    }
+
+    void clear() { *this = MeasurementBatch(); }
+
+private:
+    void internPatient(const MeasurementBatch &other, qint32 patientId)
+    {
+        if (!patients.contains(patientId))
+            patients.insert(patientId, other.patients.value(patientId));
+    }
+};
+
+// Bağlantı başına hasta adı önbelleği: ölçüm sorguları patients'ı JOIN etmez, partiye her
+// farklı hasta için bir kez ad eklenir. Adlar değişmediği için önbellek hiç boşaltılmaz.
+class PatientNameCache
+{
+public:
+    explicit PatientNameCache(const QSqlDatabase &db) : m_select(db) {}
+
+    bool prepare() { return m_select.prepare("SELECT first_name, last_name FROM patients WHERE id = ?"); }
+
+    void insert(qint32 patientId, const PatientName &name) { m_names.insert(patientId, name); }
+
+    PatientName name(qint32 patientId)
+    {
+        auto it = m_names.constFind(patientId);
+        if (it != m_names.constEnd())
+            return it.value();
+
+        PatientName name;
+        m_select.bindValue(0, patientId);
+        if (m_select.exec() && m_select.next())
+            name = PatientName{m_select.value(0).toString(), m_select.value(1).toString()};
+        m_select.finish();
+        m_names.insert(patientId, name);
+        return name;
+    }
+
+    void attach(MeasurementBatch &batch)
+    {
+        for (qint32 patientId : std::as_const(batch.patientIds)) {
+            if (!batch.patients.contains(patientId))
+                batch.patients.insert(patientId, name(patientId));
+        }
+    }
+
+private:
+    QSqlQuery m_select;
+    QHash<qint32, PatientName> m_names;
+};
+
+Q_DECLARE_METATYPE(MeasurementBatch)
+
+#endif // MEASUREMENTBATCH_H
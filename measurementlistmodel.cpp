@@ -1,5 +1,6 @@
 #include "measurementlistmodel.h"
 #include <QDebug>
+#include <limits>
 
 MeasurementListModel::MeasurementListModel(QObject *parent)
     : QAbstractListModel(parent)
@@ -23,12 +24,14 @@ void MeasurementListModel::setupDatabaseConnections()
             this, &MeasurementListModel::onDatabaseReady);
     connect(m_dbManager, &DatabaseManager::patientAdded,
             this, &MeasurementListModel::onPatientAdded);
-    connect(m_dbManager, &DatabaseManager::measurementSaved,
-            this, &MeasurementListModel::onMeasurementSaved);
-    connect(m_dbManager, &DatabaseManager::dataLoaded,
-            this, &MeasurementListModel::onDataLoaded);
-    connect(m_dbManager, &DatabaseManager::filteredDataLoaded,
-            this, &MeasurementListModel::onFilteredDataLoaded);
+    connect(m_dbManager, &DatabaseManager::measurementsSaved,
+            this, &MeasurementListModel::onMeasurementsSaved);
+    connect(m_dbManager, &DatabaseManager::measurementsInserted,
+            this, &MeasurementListModel::onMeasurementsInserted);
+    connect(m_dbManager, &DatabaseManager::pageLoaded,
+            this, &MeasurementListModel::onPageLoaded);
+    connect(m_dbManager, &DatabaseManager::pendingQueriesChanged,
+            this, &MeasurementListModel::pendingQueriesChanged);
     connect(m_dbManager, &DatabaseManager::error,
             this, &MeasurementListModel::onDatabaseError);
 }
@@ -36,22 +39,22 @@ void MeasurementListModel::setupDatabaseConnections()
 int MeasurementListModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid()) return 0;
-    return m_data.count();
+    return m_data.size();
 }
 
 QVariant MeasurementListModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() >= m_data.count())
+    if (!index.isValid() || index.row() >= m_data.size())
         return QVariant();
 
-    const QVariantMap &item = m_data.at(index.row());
+    const int row = index.row();
 
     switch (role) {
-    case FirstNameRole: return item.value("first_name");
-    case LastNameRole: return item.value("last_name");
-    case Spo2Role: return item.value("spo2");
-    case PrRole: return item.value("pr");
-    case TimestampRole: return item.value("timestamp");
+    case FirstNameRole: return m_data.patient(row).firstName;
+    case LastNameRole: return m_data.patient(row).lastName;
+    case Spo2Role: return static_cast<int>(m_data.spo2.at(row));
+    case PrRole: return static_cast<int>(m_data.pr.at(row));
+    case TimestampRole: return m_data.formattedTimestamp(row);
     default: return QVariant();
     }
 }
@@ -67,6 +70,39 @@ QHash<int, QByteArray> MeasurementListModel::roleNames() const
     return roles;
 }
 
+bool MeasurementListModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_hasMore && !m_pagePending;
+}
+
+void MeasurementListModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent))
+        requestPage(false);
+}
+
+void MeasurementListModel::requestPage(bool firstPage)
+{
+    if (firstPage) {
+        ++m_requestId;
+        m_firstPagePending = true;
+    }
+
+    qint64 beforeTimestampMs = DatabaseReader::FirstPageCursor;
+    qint64 beforeId = DatabaseReader::FirstPageCursor;
+    if (!firstPage && !m_data.isEmpty()) {
+        beforeTimestampMs = m_data.timestampsMs.last();
+        beforeId = m_data.ids.last();
+    }
+
+    // Süzgeçli sayfa da aynı keyset imlecinden devam eder: seyrek eşleşmede bile her sayfa
+    // önceki sayfanın bittiği satırdan taramayı sürdürür, baştan tarama yoktur.
+    // Filtre kapalıyken sınırlar 0'dır (etkin değil).
+    m_pagePending = true;
+    m_dbManager->loadPage(DatabaseReader::ListChannel, m_requestId, m_spo2Min, m_spo2Max, m_prMin, m_prMax,
+                          beforeTimestampMs, beforeId, PageSize);
+}
+
 bool MeasurementListModel::addPatient(const QString &firstName, const QString &lastName)
 {
     if (m_addPatientPending) {
@@ -116,11 +152,7 @@ void MeasurementListModel::refreshData()
         return;
     }
 
-    if (m_filterActive) {
-        m_dbManager->loadFilteredData(m_spo2Min, m_spo2Max, m_prMin, m_prMax);
-    } else {
-        m_dbManager->loadAllData();
-    }
+    requestPage(true);
 }
 
 void MeasurementListModel::applyFilter(int spo2Min, int spo2Max, int prMin, int prMax)
@@ -147,7 +179,7 @@ void MeasurementListModel::applyFilter(int spo2Min, int spo2Max, int prMin, int
     qDebug() << "MeasurementListModel: Filtre uygulanıyor - SpO2:" << spo2Min << "-" << spo2Max
              << "PR:" << prMin << "-" << prMax;
 
-    m_dbManager->loadFilteredData(spo2Min, spo2Max, prMin, prMax);
+    refreshData();
 }
 
 void MeasurementListModel::clearFilter()
@@ -156,16 +188,16 @@ void MeasurementListModel::clearFilter()
 
     m_filterActive = false;
     m_spo2Min = m_spo2Max = m_prMin = m_prMax = 0;
-    m_dbManager->loadAllData();
+    refreshData();
 }
 
 QString MeasurementListModel::getLastPatientName() const
 {
     if (m_data.isEmpty()) return "Hasta Bulunamadı";
 
-    const QVariantMap &lastRecord = m_data.first();
-    QString firstName = lastRecord.value("first_name").toString();
-    QString lastName = lastRecord.value("last_name").toString();
+    const PatientName lastRecord = m_data.patient(0);
+    const QString &firstName = lastRecord.firstName;
+    const QString &lastName = lastRecord.lastName;
 
     if (firstName.isEmpty() && lastName.isEmpty()) return "Hasta Bulunamadı";
 
@@ -188,7 +220,6 @@ void MeasurementListModel::onPatientAdded(int newPatientId, bool success)
         qDebug() << "MeasurementListModel: Yeni hasta eklendi, ID:" << newPatientId
                  << "Ad:" << m_pendingFirstName << m_pendingLastName;
         emit activePatientChanged(true);
-        refreshData(); // Veri listesini güncelle
     } else {
         qWarning() << "MeasurementListModel: Hasta eklenemedi -" << m_pendingFirstName << m_pendingLastName;
         emit activePatientChanged(false);
@@ -199,26 +230,93 @@ void MeasurementListModel::onPatientAdded(int newPatientId, bool success)
     m_pendingLastName.clear();
 }
 
-void MeasurementListModel::onMeasurementSaved(bool success)
+void MeasurementListModel::onMeasurementsSaved(int count, bool success)
 {
+    // Satırlar measurementsInserted ile zaten eklendi; tam yeniden yükleme yok
     if (success) {
-        qDebug() << "MeasurementListModel: Ölçüm başarıyla kaydedildi (Patient ID:" << m_currentPatientId << ")";
-        refreshData(); // Veri listesini güncelle
+        qDebug() << "MeasurementListModel:" << count << "ölçüm kaydedildi (Patient ID:" << m_currentPatientId << ")";
     } else {
-        qWarning() << "MeasurementListModel: Ölçüm kaydedilemedi (Patient ID:" << m_currentPatientId << ")";
+        qWarning() << "MeasurementListModel:" << count << "ölçüm kaydedilemedi (Patient ID:" << m_currentPatientId << ")";
     }
 }
 
-void MeasurementListModel::onDataLoaded(const QVariantList &data)
+void MeasurementListModel::onMeasurementsInserted(const MeasurementBatch &rows)
 {
-    qDebug() << "MeasurementListModel: Tüm veriler yüklendi, kayıt sayısı:" << data.size();
-    updateModelData(data);
+    // Okumalar ayrı bağlantıda: yeniden yüklemenin anlık görüntüsü bu satırları içerebilir
+    // de içermeyebilir de. İlk yanıt gelene kadar bekletilir, sıfırlamadan sonra eklenir.
+    if (m_firstPagePending) {
+        for (int i = 0; i < rows.size(); ++i)
+            m_insertedDuringReload.appendRow(rows, i);
+        return;
+    }
+
+    prependInserted(rows);
 }
 
-void MeasurementListModel::onFilteredDataLoaded(const QVariantList &data)
+void MeasurementListModel::prependInserted(const MeasurementBatch &rows)
 {
-    qDebug() << "MeasurementListModel: Filtrelenmiş veriler yüklendi, kayıt sayısı:" << data.size();
-    updateModelData(data);
+    // Listede zaten olan (en üstteki satırdan eski id'li) satırlar atlanır
+    const qint64 topId = m_data.isEmpty() ? std::numeric_limits<qint64>::min() : m_data.ids.first();
+    QVector<int> matching;
+    for (int i = 0; i < rows.size(); ++i) {
+        if (rows.ids.at(i) > topId && matchesFilter(rows.spo2.at(i), rows.pr.at(i)))
+            matching.append(i);
+    }
+    if (matching.isEmpty())
+        return;
+
+    // Liste en yeniden eskiye sıralı; parti eklenme sırasıyla gelir, her satır başa eklenir
+    beginInsertRows(QModelIndex(), 0, matching.size() - 1);
+    for (int i : std::as_const(matching))
+        m_data.prependRow(rows, i);
+    endInsertRows();
+}
+
+bool MeasurementListModel::matchesFilter(int spo2, int pr) const
+{
+    if (!m_filterActive)
+        return true;
+
+    if (m_spo2Min > 0 && spo2 < m_spo2Min) return false;
+    if (m_spo2Max > 0 && m_spo2Max <= 100 && spo2 > m_spo2Max) return false;
+    if (m_prMin > 0 && pr < m_prMin) return false;
+    if (m_prMax > 0 && m_prMax <= 300 && pr > m_prMax) return false;
+    return true;
+}
+
+void MeasurementListModel::onPageLoaded(int channel, int requestId, const MeasurementBatch &rows, bool hasMore)
+{
+    // Başka bir kanalın yanıtı ya da filtre değiştikten sonra gelen eski yanıt
+    if (channel != DatabaseReader::ListChannel || requestId != m_requestId)
+        return;
+
+    m_pagePending = false;
+    m_hasMore = hasMore;
+    appendRows(rows);
+}
+
+void MeasurementListModel::appendRows(const MeasurementBatch &rows)
+{
+    if (m_firstPagePending) {
+        m_firstPagePending = false;
+        updateModelData(rows);
+
+        // Yükleme sürerken kaydedilenler: anlık görüntüde olmayanlar başa eklenir
+        if (!m_insertedDuringReload.isEmpty()) {
+            const MeasurementBatch inserted = m_insertedDuringReload;
+            m_insertedDuringReload.clear();
+            prependInserted(inserted);
+        }
+        return;
+    }
+    if (rows.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), m_data.size(), m_data.size() + rows.size() - 1);
+    m_data.reserve(m_data.size() + rows.size());
+    for (int i = 0; i < rows.size(); ++i)
+        m_data.appendRow(rows, i);
+    endInsertRows();
 }
 
 void MeasurementListModel::onDatabaseError(const QString &message)
@@ -234,19 +332,11 @@ void MeasurementListModel::onDatabaseError(const QString &message)
     }
 }
 
-void MeasurementListModel::updateModelData(const QVariantList &data)
+void MeasurementListModel::updateModelData(const MeasurementBatch &data)
 {
     beginResetModel();
-    m_data.clear();
-
-    for (const QVariant &item : data) {
-        if (item.canConvert<QVariantMap>()) {
-            m_data.append(item.toMap());
-        } else {
-            qWarning() << "MeasurementListModel: Invalid QVariant in updateModelData";
-        }
-    }
-
+    // Diziler paylaşımlıdır; kopya yok
+    m_data = data;
     endResetModel();
 
     qDebug() << "MeasurementListModel: Model güncellendi, toplam kayıt:" << m_data.size();
@@ -2,15 +2,21 @@
 #define MEASUREMENTLISTMODEL_H
 
 #include <QAbstractListModel>
-#include <QVariantMap>
 #include "databasemanager.h"
 
 class MeasurementListModel : public QAbstractListModel
 {
     Q_OBJECT
     Q_PROPERTY(bool hasActivePatient READ hasActivePatient NOTIFY activePatientChanged)
+    // Yanıtı beklenen okuma istekleri (eskiyenler okuyucuda atlanır; bkz. DatabaseReader::setLatestQuery)
+    Q_PROPERTY(int pendingQueries READ pendingQueries NOTIFY pendingQueriesChanged)
 
 public:
+    // Liste görünümü (süzgeçli ya da değil) sayfa sayfa doldurulur: ilk sayfa yüklenir, ListView
+    // sona yaklaştıkça (cacheBuffer payı) fetchMore bir sonraki sayfayı keyset imleciyle ister.
+    // Modelde yalnızca görüntülenen ve önceden istenen sayfalar tutulur.
+    static constexpr int PageSize = 100;
+
     explicit MeasurementListModel(QObject *parent = nullptr);
 
     enum Roles {
@@ -25,37 +31,52 @@ public:
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
 
     // QML'den çağrılabilir metodlar
     Q_INVOKABLE QString getLastPatientName() const;
     Q_INVOKABLE bool addPatient(const QString &firstName, const QString &lastName);
     Q_INVOKABLE bool hasActivePatient() const;
+    int pendingQueries() const { return m_dbManager->pendingQueries(); }
+    int currentPatientId() const { return m_currentPatientId; }
     Q_INVOKABLE void refreshData();
 
     // Yeni filtre metodları
     Q_INVOKABLE void applyFilter(int spo2Min, int spo2Max, int prMin, int prMax);
     Q_INVOKABLE void clearFilter();
 
-    // Ölçüm kaydetme
+    // Ölçüm kaydetme (DatabaseWorker kuyruğuna; toplu yazılır)
     void saveMeasurement(int spo2, int pr);
+    DatabaseManager *databaseManager() const { return m_dbManager; }
 
 signals:
     void activePatientChanged(bool ready);
+    void pendingQueriesChanged(int count);
 
 private slots:
     // DatabaseManager'dan gelen sinyalleri işle
     void onDatabaseReady();
     void onPatientAdded(int newPatientId, bool success);
-    void onMeasurementSaved(bool success);
-    void onDataLoaded(const QVariantList &data);
-    void onFilteredDataLoaded(const QVariantList &data);
+    void onMeasurementsSaved(int count, bool success);
+    void onMeasurementsInserted(const MeasurementBatch &rows);
+    void onPageLoaded(int channel, int requestId, const MeasurementBatch &rows, bool hasMore);
     void onDatabaseError(const QString &message);
 
 private:
     void setupDatabaseConnections();
-    void updateModelData(const QVariantList &data);
+    void updateModelData(const MeasurementBatch &data);
+    // firstPage: imleç baştan, gelen sayfa modeli değiştirir; değilse son satırdan devam edip sona ekler
+    void requestPage(bool firstPage);
+    // İlk sayfa modeli değiştirir, sonrakiler sona eklenir
+    void appendRows(const MeasurementBatch &rows);
+    // Yeni kaydedilen satırlar: filtreyle eşleşen ve en üstteki satırdan yeni olanlar başa eklenir
+    void prependInserted(const MeasurementBatch &rows);
+    // Etkin filtre (yoksa her satır) ile eşleşiyor mu; worker'ın filtre koşullarıyla aynı
+    bool matchesFilter(int spo2, int pr) const;
 
-    QList<QVariantMap> m_data;
+    // En yeniden eskiye; data() sütun dizilerini indeksler, zaman damgası gösterimde biçimlenir
+    MeasurementBatch m_data;
     DatabaseManager *m_dbManager;
     int m_currentPatientId;
 
@@ -63,6 +84,14 @@ private:
     bool m_filterActive;
     int m_spo2Min, m_spo2Max, m_prMin, m_prMax;
 
+    // Sayfalama durumu: m_requestId ListChannel'daki nesil sayacıdır, yalnızca ona ait yanıt uygulanır (eski
+    // filtre yanıtları atılır); sayfa beklenirken m_pagePending true kalır ve fetchMore çalışmaz
+    int m_requestId = 0;
+    bool m_pagePending = false;
+    bool m_firstPagePending = false;
+    MeasurementBatch m_insertedDuringReload; // ilk yanıt beklenirken gelen kayıtlar
+    bool m_hasMore = false;
+
     // Pending işlemler için bayraklar
     bool m_addPatientPending;
     QString m_pendingFirstName, m_pendingLastName;
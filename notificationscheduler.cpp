@@ -0,0 +1,135 @@
+#include "notificationscheduler.h"
+#include <QDebug>
+
+NotificationScheduler::NotificationScheduler(QObject *parent)
+    : QObject(parent)
+{
+    // Pencere yokken de veri akmaya devam etsin diye sabit bir kalp atışı
+    m_heartbeat.setInterval(16);
+    m_heartbeat.setTimerType(Qt::PreciseTimer);
+    connect(&m_heartbeat, &QTimer::timeout, this, &NotificationScheduler::onHeartbeat);
+    m_heartbeat.start();
+}
+
+void NotificationScheduler::attachWindow(QQuickWindow *window)
+{
+    if (m_window == window)
+        return;
+
+    if (m_window)
+        disconnect(m_window, nullptr, this, nullptr);
+
+    m_window = window;
+    m_frameRequested = false;
+
+    if (m_window) {
+        // afterAnimating GUI thread'inde, sync'ten hemen önce kare başına bir kez gelir
+        connect(m_window, &QQuickWindow::afterAnimating,
+                this, &NotificationScheduler::onAfterAnimating);
+        connect(m_window, &QWindow::visibilityChanged,
+                this, &NotificationScheduler::onVisibilityChanged);
+        qDebug() << "NotificationScheduler: Bildirimler pencere karesine hizalandı";
+    }
+
+    updatePaused();
+}
+
+void NotificationScheduler::markDirty(int &clientDirty, int channels)
+{
+    for (int bit = 0; bit < CHANNEL_COUNT; ++bit) {
+        const int channel = 1 << bit;
+        if ((channels & channel) && (clientDirty & channel))
+            ++m_coalesced[bit];
+    }
+    clientDirty |= channels;
+    if (channels)
+        m_pending = true;
+}
+
+int NotificationScheduler::takeDirty(int &clientDirty)
+{
+    const int channels = clientDirty;
+    clientDirty = 0;
+
+    for (int bit = 0; bit < CHANNEL_COUNT; ++bit) {
+        if (channels & (1 << bit))
+            ++m_emitted[bit];
+    }
+    return channels;
+}
+
+qint64 NotificationScheduler::coalescedCount(int channel) const
+{
+    const int index = channelIndex(channel);
+    return index < 0 ? 0 : m_coalesced[index];
+}
+
+qint64 NotificationScheduler::emittedCount(int channel) const
+{
+    const int index = channelIndex(channel);
+    return index < 0 ? 0 : m_emitted[index];
+}
+
+int NotificationScheduler::channelIndex(int channel)
+{
+    for (int bit = 0; bit < CHANNEL_COUNT; ++bit) {
+        if (channel == (1 << bit))
+            return bit;
+    }
+    return -1;
+}
+
+void NotificationScheduler::onHeartbeat()
+{
+    // Önce kaynaklar boşaltılır, bu sırada markDirty() çağrılır
+    emit tick();
+
+    if (!m_pending || m_paused)
+        return;
+
+    if (!m_window) {
+        // Pencere bağlı değil: doğrudan bildir
+        emitFrame();
+    } else if (!m_frameRequested) {
+        // Bir kare iste; bildirimler o karenin afterAnimating aşamasında yapılır
+        m_frameRequested = true;
+        m_window->update();
+    }
+}
+
+void NotificationScheduler::onAfterAnimating()
+{
+    m_frameRequested = false;
+    if (!m_paused)
+        emitFrame();
+}
+
+void NotificationScheduler::onVisibilityChanged(QWindow::Visibility visibility)
+{
+    Q_UNUSED(visibility);
+    updatePaused();
+}
+
+void NotificationScheduler::updatePaused()
+{
+    const bool paused = m_window
+                        && (m_window->visibility() == QWindow::Hidden
+                            || m_window->visibility() == QWindow::Minimized);
+    if (paused == m_paused)
+        return;
+
+    m_paused = paused;
+    m_frameRequested = false;
+    qDebug() << "NotificationScheduler:" << (m_paused ? "çizim duraklatıldı (pencere gizli)"
+                                                      : "çizim devam ediyor");
+    emit pausedChanged();
+}
+
+void NotificationScheduler::emitFrame()
+{
+    if (!m_pending)
+        return;
+
+    m_pending = false;
+    emit frame();
+}
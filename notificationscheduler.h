@@ -0,0 +1,72 @@
+#ifndef NOTIFICATIONSCHEDULER_H
+#define NOTIFICATIONSCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QTimer>
+
+// Reader bildirimlerini ekran karesine hizalar; tüm cihazlar tek zamanlayıcıyı paylaşır.
+// tick(): kaynakların (SPSC kuyrukları) boşaltılacağı an, ~60 Hz.
+// frame(): kirli kanalların bildirileceği an; pencere bağlıysa her karenin
+// afterAnimating aşamasında (vsync ile hizalı), en fazla kare başına bir kez.
+// Kirli bayraklar her istemcide (Reader) tutulur; sayaçlar burada toplanır.
+// Pencere gizli/küçültülmüşken frame() yayınlanmaz; kirli bayraklar birikir.
+class NotificationScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool paused READ isPaused NOTIFY pausedChanged)
+
+public:
+    enum Channel {
+        WaveformChannel = 0x1,
+        Spo2Channel = 0x2,
+        PrChannel = 0x4,
+        StatusChannel = 0x8,  // prob/durum bayrakları ve perfüzyon indeksi
+        StatsChannel = 0x10   // kayan pencere waveform istatistikleri
+    };
+    Q_ENUM(Channel)
+
+    static const int CHANNEL_COUNT = 5;
+
+    explicit NotificationScheduler(QObject *parent = nullptr);
+
+    void attachWindow(QQuickWindow *window);
+
+    // İstemcinin kirli maskesine kanalları ekler (zaten kirliyse birleştirilmiş sayılır)
+    void markDirty(int &clientDirty, int channels);
+    // frame() içinde çağrılır: maskeyi döndürür ve sıfırlar
+    int takeDirty(int &clientDirty);
+
+    bool isPaused() const { return m_paused; }
+
+    // Birleştirilen (yayınlanmadan üzerine yazılan) ve yayınlanan bildirim sayıları
+    Q_INVOKABLE qint64 coalescedCount(int channel) const;
+    Q_INVOKABLE qint64 emittedCount(int channel) const;
+
+signals:
+    void tick();
+    void frame();
+    void pausedChanged();
+
+private slots:
+    void onHeartbeat();
+    void onAfterAnimating();
+    void onVisibilityChanged(QWindow::Visibility visibility);
+
+private:
+    static int channelIndex(int channel);
+    void emitFrame();
+    void updatePaused();
+
+    QPointer<QQuickWindow> m_window;
+    QTimer m_heartbeat;
+    bool m_pending = false; // son kareden beri en az bir istemci kirlendi
+    bool m_frameRequested = false;
+    bool m_paused = false;
+
+    qint64 m_coalesced[CHANNEL_COUNT] = {};
+    qint64 m_emitted[CHANNEL_COUNT] = {};
+};
+
+#endif // NOTIFICATIONSCHEDULER_H
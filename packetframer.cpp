@@ -0,0 +1,71 @@
+#include "packetframer.h"
+
+int PacketFramer::writableSize() const
+{
+    const quint32 used = m_writePos - m_readPos;
+    const quint32 offset = m_writePos & Mask;
+    // Boş alan halkanın sonuna kadar bitişik olarak verilir
+    return static_cast<int>(qMin(Capacity - used, Capacity - offset));
+}
+
+void PacketFramer::reset()
+{
+    m_readPos = 0;
+    m_writePos = 0;
+    m_state = State::SeekSync;
+    m_frameSize = 0;
+}
+
+void PacketFramer::discard(quint32 bytes)
+{
+    m_readPos += bytes;
+    m_discardedBytes += bytes;
+}
+
+quint32 PacketFramer::scanForSync(quint32 available) const
+{
+    // 0xAA'yı bitişik parçalarda memchr ile ara (en fazla iki parça)
+    quint32 scanned = 0;
+    while (scanned < available) {
+        const quint32 offset = (m_readPos + scanned) & Mask;
+        const quint32 span = qMin(available - scanned, Capacity - offset);
+        const void *hit = std::memchr(m_ring + offset, 0xAA, span);
+        if (hit)
+            return scanned + static_cast<quint32>(static_cast<const quint8 *>(hit) - (m_ring + offset));
+        scanned += span;
+    }
+    return available;
+}
+
+bool PacketFramer::checksumValid() const
+{
+    // Checksum = LEN + payload (CODE dahil), 8 bit
+    const quint8 len = byteAt(2);
+    const quint32 offset = (m_readPos + 3) & Mask;
+    if (offset + len <= Capacity)
+        return checksum(len, m_ring + offset) == byteAt(3u + len);
+
+    // Halkanın sonuna sarkan payload
+    quint8 sum = len;
+    for (quint32 i = 3; i < 3u + len; ++i)
+        sum += byteAt(i);
+    return sum == byteAt(3u + len);
+}
+
+PacketView PacketFramer::frameView()
+{
+    PacketView view;
+    view.size = m_frameSize;
+
+    const quint32 offset = m_readPos & Mask;
+    if (offset + static_cast<quint32>(m_frameSize) <= Capacity) {
+        view.data = m_ring + offset;
+    } else {
+        // Halkanın sonundan başa sarkan paket: sabit ara belleğe birleştir
+        const quint32 head = Capacity - offset;
+        std::memcpy(m_scratch, m_ring + offset, head);
+        std::memcpy(m_scratch + head, m_ring, static_cast<size_t>(m_frameSize) - head);
+        view.data = m_scratch;
+    }
+    return view;
+}
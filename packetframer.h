@@ -0,0 +1,168 @@
+#ifndef PACKETFRAMER_H
+#define PACKETFRAMER_H
+
+#include <QtGlobal>
+#include <cstring>
+
+// Çerçevelenmiş paketin sahiplenmeyen görünümü: AA55 LEN CODE ... CHECKSUM
+// Veri, bir sonraki drain()/commit() çağrısına kadar geçerlidir.
+struct PacketView {
+    const quint8 *data = nullptr;
+    int size = 0;
+
+    quint8 at(int i) const { return data[i]; }
+    quint8 len() const { return data[2]; }
+    quint8 code() const { return data[3]; }
+};
+
+// Sabit kapasiteli bayt halkası + kaldığı yerden devam eden senkron arama durum makinesi.
+// Seri porttan okunan veri doğrudan halkaya yazılır (writePtr/commit), paketler
+// kopyalanmadan PacketView olarak sink'e verilir. Halkanın sonundan başa sarkan paketler
+// sabit boyutlu bir ara belleğe alınır; kararlı durumda hiçbir heap ayırması yapılmaz.
+class PacketFramer
+{
+public:
+    static constexpr quint32 Capacity = 8192;                // 2'nin kuvveti olmalı
+    static constexpr int MaxPacketSize = 2 + 1 + 255 + 1;    // AA55 + LEN + 255 bayt + checksum
+
+    PacketFramer() = default;
+
+    // Okuma için bitişik boş alan (halkanın sonuna kadar)
+    char *writePtr() { return reinterpret_cast<char *>(m_ring + (m_writePos & Mask)); }
+    int writableSize() const;
+    void commit(int bytes) { m_writePos += static_cast<quint32>(bytes); }
+
+    // Harici bir tampondan kopyalayarak besle (replay / benchmark yolları için)
+    template <typename Sink>
+    int feed(const char *data, int size, Sink &&sink);
+
+    // Halkadaki tüm tam paketleri çıkarıp sink(const PacketView &) ile bildirir.
+    // Eksik paket halkada kalır, bir sonraki çağrıda aynı durumdan devam edilir.
+    template <typename Sink>
+    int drain(Sink &&sink);
+
+    void reset();
+
+    // Protokol checksum'ı: LEN + payload (CODE dahil, len bayt), 8 bit
+    static quint8 checksum(quint8 len, const quint8 *payload)
+    {
+        quint8 sum = len;
+        for (int i = 0; i < len; ++i)
+            sum += payload[i];
+        return sum;
+    }
+
+    int bufferedBytes() const { return static_cast<int>(m_writePos - m_readPos); }
+    quint64 discardedBytes() const { return m_discardedBytes; }
+    quint64 checksumErrors() const { return m_checksumErrors; }
+    quint64 packetCount() const { return m_packetCount; }
+
+private:
+    static constexpr quint32 Mask = Capacity - 1;
+    static_assert((Capacity & Mask) == 0, "Capacity 2'nin kuvveti olmalı");
+    static_assert(Capacity >= 2 * MaxPacketSize, "Capacity en az iki paket almalı");
+
+    enum class State {
+        SeekSync,     // 0xAA aranıyor
+        AwaitSync2,   // 0x55 bekleniyor
+        AwaitLength,  // LEN bekleniyor
+        AwaitFrame    // paketin tamamı bekleniyor
+    };
+
+    quint8 byteAt(quint32 offset) const { return m_ring[(m_readPos + offset) & Mask]; }
+    void discard(quint32 bytes);
+    quint32 scanForSync(quint32 available) const;
+    bool checksumValid() const;
+    PacketView frameView();
+
+    quint8 m_ring[Capacity];
+    quint8 m_scratch[MaxPacketSize];
+    quint32 m_readPos = 0;
+    quint32 m_writePos = 0;
+
+    State m_state = State::SeekSync;
+    int m_frameSize = 0;
+
+    quint64 m_discardedBytes = 0;
+    quint64 m_checksumErrors = 0;
+    quint64 m_packetCount = 0;
+};
+
+template <typename Sink>
+int PacketFramer::feed(const char *data, int size, Sink &&sink)
+{
+    int packets = 0;
+    while (size > 0) {
+        const int chunk = qMin(size, writableSize());
+        std::memcpy(writePtr(), data, static_cast<size_t>(chunk));
+        commit(chunk);
+        data += chunk;
+        size -= chunk;
+        packets += drain(sink);
+    }
+    return packets;
+}
+
+template <typename Sink>
+int PacketFramer::drain(Sink &&sink)
+{
+    int packets = 0;
+
+    for (;;) {
+        const quint32 available = m_writePos - m_readPos;
+
+        switch (m_state) {
+        case State::SeekSync: {
+            if (available == 0)
+                return packets;
+            const quint32 skipped = scanForSync(available);
+            discard(skipped);
+            if (skipped < available)
+                m_state = State::AwaitSync2;
+            break;
+        }
+        case State::AwaitSync2:
+            if (available < 2)
+                return packets;
+            if (byteAt(1) == 0x55) {
+                m_state = State::AwaitLength;
+            } else {
+                discard(1);
+                m_state = State::SeekSync;
+            }
+            break;
+        case State::AwaitLength: {
+            if (available < 3)
+                return packets;
+            const quint8 len = byteAt(2);
+            if (len == 0) {
+                // CODE bile yok: sahte senkron, bir bayt ilerle
+                discard(1);
+                m_state = State::SeekSync;
+                break;
+            }
+            m_frameSize = 2 + 1 + len + 1;
+            m_state = State::AwaitFrame;
+            break;
+        }
+        case State::AwaitFrame:
+            if (available < static_cast<quint32>(m_frameSize))
+                return packets;
+            if (!checksumValid()) {
+                // Bozuk paket: yalnızca senkron baytını atıp tekrar ara
+                ++m_checksumErrors;
+                discard(1);
+                m_state = State::SeekSync;
+                break;
+            }
+            sink(frameView());
+            m_readPos += static_cast<quint32>(m_frameSize);
+            ++m_packetCount;
+            ++packets;
+            m_state = State::SeekSync;
+            break;
+        }
+    }
+}
+
+#endif // PACKETFRAMER_H
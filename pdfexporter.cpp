@@ -6,6 +6,7 @@
 #include <QPageLayout>
 #include <QPageSize>
 #include <QQmlContext>
+#include "reader.h"
 
 PdfExporter::PdfExporter(QObject *parent)
     : QObject(parent)
@@ -19,13 +20,37 @@ bool PdfExporter::exportWaveformToPdf(QQuickItem *canvas, const QString &patient
         return false;
     }
 
-    try {
-        QString actualPatientName = patientName.trimmed();
-        qDebug() << "PDF için gelen hasta adı:" << actualPatientName;
+    QString actualPatientName = patientName.trimmed();
+    qDebug() << "PDF için gelen hasta adı:" << actualPatientName;
+
+    QString fileName = generateFileName(actualPatientName);
+    QString fullPath = getDesktopPath() + "/" + fileName;
+
+    // Artık Canvas görüntüsü yerine, doğrudan Reader buffer'ındaki timestamp'li veriyi kullanıyoruz
+    // QML context'inden reader nesnesine erişim
+    Reader *reader = nullptr;
+    if (canvas->window()) {
+        QQmlEngine *engine = qmlEngine(canvas);
+        if (engine) {
+            QQmlContext *context = engine->rootContext();
+            if (context) {
+                reader = qobject_cast<Reader*>(context->contextProperty("reader").value<QObject*>());
+            }
+        }
+    }
 
-        QString fileName = generateFileName(actualPatientName);
-        QString fullPath = getDesktopPath() + "/" + fileName;
+    if (!reader)
+        return writeReport(fullPath, actualPatientName, spo2Value, prValue, nullptr);
 
+    // Reader'dan son 20 saniyelik waveform verisini kopyalamadan al
+    const SampleSpan<quint8> waveformData = reader->waveformSnapshot(20);
+    return writeReport(fullPath, actualPatientName, spo2Value, prValue, &waveformData);
+}
+
+bool PdfExporter::writeReport(const QString &fullPath, const QString &actualPatientName,
+                              int spo2Value, int prValue, const SampleSpan<quint8> *waveform)
+{
+    try {
         QPdfWriter pdfWriter(fullPath);
         pdfWriter.setPageSize(QPageSize::A4);
         pdfWriter.setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
@@ -128,28 +153,9 @@ bool PdfExporter::exportWaveformToPdf(QQuickItem *canvas, const QString &patient
         painter.drawText(waveTitleStartX, currentY, waveTitle);
         currentY += spacing;
 
-        // *** ANA DEĞIŞIKLIK: Reader'dan 20 saniyelik buffer verisini al ***
-        // Artık Canvas görüntüsü yerine, doğrudan buffer'daki timestamp'li veriyi kullanıyoruz
-
-        // QML context'inden reader nesnesine erişim
-        QObject *readerObj = nullptr;
-        if (canvas->window()) {
-            QQmlEngine *engine = qmlEngine(canvas);
-            if (engine) {
-                QQmlContext *context = engine->rootContext();
-                if (context) {
-                    readerObj = context->contextProperty("reader").value<QObject*>();
-                }
-            }
-        }
-
-        if (readerObj) {
-            // Reader'dan son 20 saniyelik waveform verisini al
-            QVariantList waveformData;
-            QMetaObject::invokeMethod(readerObj, "getLast20SecondsWaveform",
-                                      Q_RETURN_ARG(QVariantList, waveformData));
-
-            qDebug() << "PDF için alınan waveform nokta sayısı:" << waveformData.size();
+        if (waveform) {
+            const SampleSpan<quint8> &waveformData = *waveform;
+            qDebug() << "PDF için alınan waveform nokta sayısı:" << waveformData.size;
 
             if (!waveformData.isEmpty()) {
                 // Grafik boyutları - sayfa genişliğinin %75'i
@@ -188,7 +194,7 @@ bool PdfExporter::exportWaveformToPdf(QQuickItem *canvas, const QString &patient
                 painter.drawText(noteStartX, currentY, note);
 
                 qDebug() << "PDF başarıyla oluşturuldu:" << fullPath;
-                qDebug() << "Waveform verileri çizildi. Nokta sayısı:" << waveformData.size();
+                qDebug() << "Waveform verileri çizildi. Nokta sayısı:" << waveformData.size;
                 return true;
             } else {
                 // Veri yok mesajı
@@ -223,14 +229,14 @@ bool PdfExporter::exportWaveformToPdf(QQuickItem *canvas, const QString &patient
     return false;
 }
 
-void PdfExporter::drawWaveformData(QPainter &painter, const QRect &rect, const QVariantList &waveformData)
+void PdfExporter::drawWaveformData(QPainter &painter, const QRect &rect, const SampleSpan<quint8> &waveformData)
 {
     if (waveformData.isEmpty()) return;
 
     painter.setRenderHint(QPainter::Antialiasing, true);
     painter.setPen(QPen(QColor("#006400"), 2)); // Koyu yeşil (Dark Green)
 
-    int dataCount = waveformData.size();
+    int dataCount = waveformData.size;
     if (dataCount < 2) return;
 
     // X ekseni adımları
@@ -245,9 +251,7 @@ void PdfExporter::drawWaveformData(QPainter &painter, const QRect &rect, const Q
     bool firstPoint = true;
 
     for (int i = 0; i < dataCount; ++i) {
-        bool ok;
-        double value = waveformData.at(i).toDouble(&ok);
-        if (!ok) continue;
+        double value = waveformData[i];
 
         // X koordinatı
         double x = rect.left() + (i * stepX);
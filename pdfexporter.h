@@ -14,6 +14,7 @@
 #include <QVariantList>
 #include <QPainterPath>
 #include <QColor>
+#include "samplering.h"
 
 class PdfExporter : public QObject
 {
@@ -27,12 +28,17 @@ public:
                                          int spo2Value = -1,
                                          int prValue = -1);
 
+    // Raporu verilen yola yazar; waveform nullptr ise "veriye erişilemiyor" notu basılır.
+    // QML'den bağımsız olduğu için benchmark ve toplu dışa aktarma yollarından da çağrılır.
+    bool writeReport(const QString &fullPath, const QString &patientName,
+                     int spo2Value, int prValue, const SampleSpan<quint8> *waveform);
+
 private:
     QString getDesktopPath() const;
     QString generateFileName(const QString &patientName) const;
 
     // Yeni metod: Waveform verilerini doğrudan çizmek için
-    void drawWaveformData(QPainter &painter, const QRect &rect, const QVariantList &waveformData);
+    void drawWaveformData(QPainter &painter, const QRect &rect, const SampleSpan<quint8> &waveformData);
 };
 
 #endif // PDFEXPORTER_H
@@ -1,208 +1,198 @@
 #include "reader.h"
+#include "waveformcodec.h"
+#include "waveformstore.h"
 #include <QDebug>
-#include <QTimer>
-#include <QCoreApplication>
-
-Reader::Reader(const QString &portName, QObject *parent)
-    : QObject(parent),
-    m_portName(portName)
+#include <cmath>
+
+Reader::Reader(const QString &portName, QThread *ioThread, NotificationScheduler *scheduler, QObject *parent)
+    : QObject(parent)
+    , m_worker(new AcquisitionWorker(portName))
+    , m_scheduler(scheduler)
+    , m_waveformModel(new WaveformModel(MAX_DISPLAY_POINTS, SAMPLE_RATE_HZ, this))
+    , m_statistics(new WaveformStatistics(SAMPLE_RATE_HZ, 5.0, this))
+    , m_history(new WaveformHistory(SAMPLE_RATE_HZ, 3600.0, this))
+    , m_waveformBuffer(SAMPLE_RATE_HZ, 20)
+    , m_portName(portName)
 {
-    // Seri port ayarları (ayrıntılar header'da bırakıldı)
-    serial.setPortName(m_portName);
-    serial.setBaudRate(375000);
-    serial.setDataBits(QSerialPort::Data8);
-    serial.setParity(QSerialPort::OddParity);
-    serial.setStopBits(QSerialPort::OneStop);
-    serial.setFlowControl(QSerialPort::NoFlowControl);
-
-    if (!openSerialPort()) {
-        qCritical() << "Port açılamadı:" << serial.errorString();
-        // Uygulamayı kapatmayalım; sadece hata loglayalım.
-        // Eğer kapatmak isterseniz: QTimer::singleShot(0, qApp, &QCoreApplication::quit);
-    } else {
-        qDebug() << m_portName << "açıldı, veri bekleniyor...";
-        // Başlangıç komutu (cihazın protokolüne göre)
-        serial.write(QByteArray::fromHex("BF5FFF"));
-        serial.flush();
-    }
-}
+    // Seri port ayarları ve paket çözme AcquisitionWorker'da; port başına thread açılmaz,
+    // tüm portlar olay güdümlü olarak aynı G/Ç thread'ini paylaşır
+    m_worker->moveToThread(ioThread);
 
-Reader::~Reader() {
-    closeSerialPort();
-}
+    connect(m_worker, &AcquisitionWorker::portStateChanged,
+            this, &Reader::onPortStateChanged);
 
-bool Reader::openSerialPort() {
-    if (serial.isOpen()) return true;
-    serial.setPortName(m_portName);
-    if (!serial.open(QIODevice::ReadWrite)) {
-        qWarning() << "openSerialPort(): açılamadı:" << serial.errorString();
-        return false;
-    }
-    // readyRead bağla (UniqueConnection ile tekrar bağlanmasını önle)
-    connect(&serial, &QSerialPort::readyRead, this, &Reader::readSerialData, Qt::UniqueConnection);
-    return true;
+    // Port açılamazsa uygulamayı kapatmayalım; worker hata loglar
+    QMetaObject::invokeMethod(m_worker, &AcquisitionWorker::openPort, Qt::QueuedConnection);
+
+    // Kuyruk ekran yenileme hızında boşaltılır, sinyaller kare başına en fazla bir kez
+    connect(m_scheduler, &NotificationScheduler::tick, this, &Reader::drainSamples);
+    connect(m_scheduler, &NotificationScheduler::frame, this, &Reader::onFrame);
 }
 
-void Reader::closeSerialPort() {
-    if (serial.isOpen()) {
-        // Veri tamponlarını temizle
-        serial.clear(QSerialPort::Input);
-        serial.clear(QSerialPort::Output);
-        disconnect(&serial, &QSerialPort::readyRead, this, &Reader::readSerialData);
-        serial.close();
+Reader::~Reader() {
+    disconnect(m_scheduler, nullptr, this, nullptr);
+    flushArchiveChunk();
+
+    // Portu kendi thread'inde kapat; worker G/Ç thread'inde silinir
+    if (m_worker->thread()->isRunning()) {
+        QMetaObject::invokeMethod(m_worker, &AcquisitionWorker::closePort, Qt::BlockingQueuedConnection);
+        m_worker->deleteLater();
+    } else {
+        delete m_worker;
     }
 }
 
-void Reader::readSerialData() {
-    // Eğer freeze durumundaysa normalde readyRead gelmeyecek çünkü port kapalı.
-    // Ancak ek güvenlik olarak burada da kontrol edelim:
-    if (m_frozen || !serial.isOpen()) {
-        // Port kapalıysa ya da frozen ise hiçbir işlem yapma.
-        return;
-    }
+void Reader::drainSamples() {
+    // Her değişiklik ayrı işaretlenir: aynı karede tekrar kirlenen kanal birleştirilmiş sayılır
+    m_worker->samples().drain([&](const AcquiredSample &sample) {
+        // Freeze sırasında kuyrukta kalan örnekler ekrana yansıtılmaz
+        if (m_frozen)
+            return;
 
-    QByteArray incoming = serial.readAll();
-    if (incoming.isEmpty()) return;
-
-    buffer.append(incoming);
-
-    // Paket işlemi: AA55 LEN CODE ... CHECKSUM
-    while (true) {
-        // Header arama
-        int start = -1;
-        for (int i = 0; i + 1 < buffer.size(); ++i) {
-            if (static_cast<unsigned char>(buffer.at(i)) == 0xAA &&
-                static_cast<unsigned char>(buffer.at(i+1)) == 0x55) {
-                start = i;
-                break;
-            }
+        if (sample.has(Biolight::Pleth) && sample.waveform >= 0) {
+            m_waveformBuffer.append(static_cast<quint8>(sample.waveform), sample.timestamp);
+            m_statistics->addSample(static_cast<float>(sample.waveform));
+            m_history->append(static_cast<quint8>(sample.waveform), sample.timestamp);
+            if (m_store && m_patientId > 0)
+                archiveSample(static_cast<quint8>(sample.waveform), sample.timestamp);
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::WaveformChannel | NotificationScheduler::StatsChannel);
         }
 
-        if (start < 0) {
-            // Header yok — bekle, ancak buffer çok büyükse temizle
-            if (buffer.size() > 4096) {
-                buffer.clear();
-                qWarning() << "readSerialData: header bulunamadı, buffer temizlendi (çok büyük).";
-            }
-            break;
+        // Sayısal değerler yalnızca pakette varsa ve değiştiklerinde bildirilir
+        if (sample.has(Biolight::Spo2) && sample.spo2 != m_spo2) {
+            m_spo2 = sample.spo2;
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::Spo2Channel);
         }
-
-        if (start > 0) {
-            // Başlangıç dışındaki ön veriyi at
-            buffer.remove(0, start);
+        if (sample.has(Biolight::PulseRate) && sample.pr != m_pr) {
+            m_pr = sample.pr;
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::PrChannel);
         }
-
-        if (buffer.size() < 4) {
-            // Başlık var ama yeterli veri yok (AA55 + LEN + en az CODE + CHECKSUM)
-            break;
+        if (sample.has(Biolight::ProbeOff) && sample.probeOff != m_probeOff) {
+            m_probeOff = sample.probeOff;
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::StatusChannel);
         }
-
-        quint8 len = static_cast<quint8>(buffer.at(2));
-        int totalSize = 2 + 1 + len + 1; // AA55 + LEN + (len bytes) + checksum
-
-        if (buffer.size() < totalSize) {
-            // Tam paket gelmemiş
-            break;
+        if (sample.has(Biolight::PerfusionIndex) && sample.perfusion != m_perfusion) {
+            m_perfusion = sample.perfusion;
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::StatusChannel);
         }
-
-        QByteArray packet = buffer.left(totalSize);
-        processPacket(packet);
-        buffer.remove(0, totalSize);
-    }
+        if (sample.has(Biolight::StatusFlags) && sample.status != m_statusFlags) {
+            m_statusFlags = sample.status;
+            m_scheduler->markDirty(m_dirty, NotificationScheduler::StatusChannel);
+        }
+    });
 }
 
-void Reader::processPacket(const QByteArray &packet) {
-    if (packet.size() < 5) return;
-
-    quint8 len  = static_cast<quint8>(packet.at(2));
-    // Kontrol: paket boyutu len ile uyumlu mu?
-    if (packet.size() < (2 + 1 + len + 1)) return;
-
-    quint8 checksumByte = static_cast<quint8>(packet.at(packet.size() - 1));
+void Reader::onFrame() {
+    if (!m_dirty)
+        return;
 
-    // Checksum hesaplama (LEN + payload)
-    quint8 sum = 0;
-    sum += len;
-    for (int i = 3; i < 3 + len && i < packet.size() - 1; ++i) {
-        sum += static_cast<quint8>(packet.at(i));
+    const int channels = m_scheduler->takeDirty(m_dirty);
+    if (channels & NotificationScheduler::WaveformChannel) {
+        // Eski örnekler halkada O(1) olarak üzerine yazılır; ayrı temizlik gerekmez
+        // Ekran modeline yalnızca yeni örnekler eklenir - kare başına bir kez
+        updateDisplayWaveform();
+        m_history->publish();
+        emit waveformChanged();
     }
-    sum &= 0xFF;
+    if (channels & NotificationScheduler::Spo2Channel)
+        emit spo2Changed();
+    if (channels & NotificationScheduler::PrChannel)
+        emit prChanged();
+    if (channels & NotificationScheduler::StatusChannel)
+        emit statusChanged();
+    if (channels & NotificationScheduler::StatsChannel)
+        m_statistics->publish();
+}
 
-    if (sum != checksumByte) {
-        qWarning() << "Packet checksum mismatch. Beklenen:" << checksumByte << "Hesaplanan:" << sum;
-        return;
+void Reader::archiveSample(quint8 value, qint64 timestamp) {
+    // Örnek zamanları parça başlangıcı + örnekleme hızından türetilir; gerçek zaman
+    // ContinuityToleranceMs'ten fazla saparsa (port kesintisi, replay) yeni parça başlatılır
+    if (!m_chunk.isEmpty()) {
+        const qint64 expected = m_chunkStartMs
+            + static_cast<qint64>(m_chunk.size() * 1000.0 / m_waveformBuffer.sampleRate());
+        if (qAbs(timestamp - expected) > WaveformChunk::ContinuityToleranceMs)
+            flushArchiveChunk();
+    }
+    if (m_chunk.isEmpty()) {
+        m_chunk.reserve(m_chunkSamples);
+        m_chunkStartMs = timestamp;
     }
 
-    quint8 code = static_cast<quint8>(packet.at(3));
-
-    if (code == 21 && len >= 10) {
-        // waveform değeri (örnek index'ler, cihaz protokolüne göre kontrol et)
-        quint8 waveformVal = static_cast<quint8>(packet.at(5));
-        if (waveformVal != 127) {
-            static int lastValue = 0;
-            int smooth = (lastValue + waveformVal) / 2;
-            lastValue = smooth;
-
-            qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-            m_waveformBuffer.enqueue(WaveformPoint(smooth, currentTime));
+    m_chunk.append(static_cast<char>(value));
+    if (m_chunk.size() >= m_chunkSamples)
+        flushArchiveChunk();
+}
 
-            // 20 saniyeden eski verileri temizle
-            cleanOldData();
+void Reader::flushArchiveChunk() {
+    if (m_chunk.isEmpty())
+        return;
 
-            // Ekran için güncelle (m_waveform doldur)
-            updateDisplayWaveform();
+    if (m_store && m_patientId > 0) {
+        WaveformStore *store = m_store;
+        const int patientId = m_patientId;
+        const qint64 startMs = m_chunkStartMs;
+        const double rate = m_waveformBuffer.sampleRate();
+        const QByteArray samples = m_chunk;
+        QMetaObject::invokeMethod(store, [store, patientId, startMs, rate, samples]() {
+            store->appendChunk(patientId, startMs, rate, samples);
+        }, Qt::QueuedConnection);
+    }
+    // Gönderilen tampon paylaşımlı kalır; yeni parça yeni tampona yazılır
+    m_chunk = QByteArray();
+}
 
-            emit waveformChanged();
-        }
+void Reader::setWaveformStore(WaveformStore *store, double chunkSeconds) {
+    flushArchiveChunk();
+    m_store = store;
+    m_chunkSamples = qMax(1, static_cast<int>(std::lround(chunkSeconds * m_waveformBuffer.sampleRate())));
+}
 
-        // SPO2 (örnek konum; cihaz protokolüne göre kontrol et)
-        quint8 spo2  = static_cast<quint8>(packet.at(7));
-        if (spo2 == 127) {
-            m_spo2 = -1;
-        } else {
-            m_spo2 = static_cast<int>(spo2);
-        }
-        emit spo2Changed();
+void Reader::setPatientId(int patientId) {
+    if (patientId == m_patientId)
+        return;
 
-        // PR (örnek 2 byte)
-        quint8 pr_msb = static_cast<quint8>(packet.at(8));
-        quint8 pr_lsb = static_cast<quint8>(packet.at(9));
-        int pr = (static_cast<int>(pr_msb) << 8) | static_cast<int>(pr_lsb);
-        if (pr == 255) {
-            m_pr = -1;
-        } else {
-            m_pr = pr;
-        }
-        emit prChanged();
-    } else {
-        // Diğer kodlar burada işlenebilir
-    }
+    flushArchiveChunk();
+    m_patientId = patientId;
+    qDebug() << "Reader" << m_portName << "waveform arşivi hasta ID:" << patientId;
 }
 
-void Reader::cleanOldData() {
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 twentySecondsAgo = currentTime - (20 * 1000); // 20 saniye
+void Reader::onPortStateChanged(bool open) {
+    if (!m_unfreezePending)
+        return;
 
-    while (!m_waveformBuffer.isEmpty() &&
-           m_waveformBuffer.first().timestamp < twentySecondsAgo) {
-        m_waveformBuffer.dequeue();
+    m_unfreezePending = false;
+    if (!open) {
+        qWarning() << "unfreeze(): seri port açılamadı, freeze devam ediyor.";
+        // Eğer açılamadıysa frozen durumunu koru ve bildir.
+        emit frozenChanged();
+        return;
     }
+
+    m_frozen = false;
+    qDebug() << "🔓 WAVEFORM DEVAM EDİYOR (seri port yeniden açıldı)";
+    emit frozenChanged();
 }
 
 void Reader::updateDisplayWaveform() {
-    m_waveform.clear();
-    int totalPoints = m_waveformBuffer.size();
-    int startIndex = qMax(0, totalPoints - MAX_DISPLAY_POINTS);
+    m_waveformModel->appendSamples(m_waveformBuffer.since(m_displayCursor));
+    m_displayCursor = m_waveformBuffer.totalWritten();
+}
 
-    for (int i = startIndex; i < totalPoints; ++i) {
-        m_waveform.append(m_waveformBuffer.at(i).value);
-    }
+void Reader::setRetentionSeconds(int seconds) {
+    if (seconds <= 0 || seconds == m_waveformBuffer.retentionSeconds())
+        return;
+
+    m_waveformBuffer.setRetentionSeconds(seconds);
+    qDebug() << "Waveform saklama süresi:" << seconds << "saniye (" << m_waveformBuffer.capacity() << "örnek)";
+    emit retentionSecondsChanged();
 }
 
 QVariantList Reader::getLast20SecondsWaveform() const {
     QVariantList result;
-    for (const WaveformPoint &point : m_waveformBuffer) {
-        result.append(point.value);
+    const SampleSpan<quint8> span = m_waveformBuffer.lastSeconds(20);
+    result.reserve(span.size);
+    for (quint8 value : span) {
+        result.append(static_cast<int>(value));
     }
     qDebug() << "getLast20SecondsWaveform() - dönen nokta sayısı:" << result.size();
     return result;
@@ -210,42 +200,38 @@ QVariantList Reader::getLast20SecondsWaveform() const {
 
 QVariantList Reader::getLast20SecondsTimestamps() const {
     QVariantList result;
-    for (const WaveformPoint &point : m_waveformBuffer) {
-        result.append(point.timestamp);
+    const SampleSpan<quint8> span = m_waveformBuffer.lastSeconds(20);
+    result.reserve(span.size);
+    for (int i = 0; i < span.size; ++i) {
+        result.append(span.timestampAt(i));
     }
     return result;
 }
 
+QByteArray Reader::getLast20SecondsWaveformPacked() const {
+    const SampleSpan<quint8> span = m_waveformBuffer.lastSeconds(20);
+    const qint64 startMs = span.isEmpty() ? 0 : span.timestampAt(0);
+    return WaveformCodec::packFrame(span.data, span.size, startMs, span.sampleRate);
+}
+
 // Freeze: portu kapat -> işletim sistemi buffer'ı uygulamaya gelmez
 void Reader::freeze() {
     if (!m_frozen) {
         m_frozen = true;
-        // Seri portu kapat (readyRead gelmez)
-        closeSerialPort();
-        // Geçici bufferları temizle
-        buffer.clear();
+        flushArchiveChunk();
+        m_unfreezePending = false;
+        // Seri portu acquisition thread'inde kapat (readyRead gelmez, yarım paketler atılır)
+        QMetaObject::invokeMethod(m_worker, &AcquisitionWorker::closePort, Qt::QueuedConnection);
         qDebug() << "🔒 WAVEFORM DONDURULDU (seri port kapatıldı)";
         emit frozenChanged();
     }
 }
 
 void Reader::unfreeze() {
-    if (m_frozen) {
-        // Tekrar açmayı dene
-        bool ok = openSerialPort();
-        if (!ok) {
-            qWarning() << "unfreeze(): seri port açılamadı, freeze devam ediyor.";
-            // Eğer açılamadıysa frozen durumunu koru ve bildir.
-            // m_frozen true kalsın.
-            emit frozenChanged();
-            return;
-        }
-
-        m_frozen = false;
-        // Freeze sırasında oluşmuş gereksiz local buffer'ı temizle
-        buffer.clear();
-        qDebug() << "🔓 WAVEFORM DEVAM EDİYOR (seri port yeniden açıldı)";
-        emit frozenChanged();
+    if (m_frozen && !m_unfreezePending) {
+        // Tekrar açmayı dene; sonuç onPortStateChanged ile gelir
+        m_unfreezePending = true;
+        QMetaObject::invokeMethod(m_worker, &AcquisitionWorker::openPort, Qt::QueuedConnection);
     }
 }
 
@@ -254,6 +240,40 @@ void Reader::toggleFreeze() {
     else freeze();
 }
 
+void Reader::startCapture(const QString &directory) {
+    AcquisitionWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, directory]() { worker->setCaptureDirectory(directory); },
+                              Qt::QueuedConnection);
+}
+
+void Reader::stopCapture() {
+    startCapture(QString());
+}
+
+void Reader::setReplaySpeed(double speed) {
+    AcquisitionWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, speed]() { worker->setReplaySpeed(speed); },
+                              Qt::QueuedConnection);
+}
+
+void Reader::setFilterConfig(const PlethFilterConfig &config) {
+    AcquisitionWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, config]() { worker->setFilterConfig(config); },
+                              Qt::QueuedConnection);
+
+    if (!qFuzzyCompare(m_waveformBuffer.sampleRate(), config.outputRateHz())) {
+        // Parça tek bir örnekleme hızında olmalı; parça süresi saniye olarak korunur
+        flushArchiveChunk();
+        const double chunkSeconds = m_chunkSamples / m_waveformBuffer.sampleRate();
+        m_waveformBuffer.setSampleRate(config.outputRateHz());
+        m_chunkSamples = qMax(1, static_cast<int>(std::lround(chunkSeconds * m_waveformBuffer.sampleRate())));
+        m_displayCursor = m_waveformBuffer.totalWritten();
+        m_waveformModel->clear();
+    }
+    m_statistics->setSampleRate(config.outputRateHz());
+    m_history->setSampleRate(config.outputRateHz());
+}
+
 bool Reader::setResponseTime(int seconds) {
     qDebug() << "setResponseTime çağrıldı:" << seconds << "saniye";
 
@@ -288,26 +308,8 @@ bool Reader::setResponseTime(int seconds) {
 }
 
 void Reader::sendSettingToBiolight(quint8 data) {
-    if (!serial.isOpen()) {
-        qWarning() << "sendSettingToBiolight: seri port kapalı, paket gönderilemedi.";
-        return;
-    }
-
-    // Protokol: AA55 LEN CODE DATA CHECKSUM
-    QByteArray packet;
-    packet.append(static_cast<char>(0xAA));
-    packet.append(static_cast<char>(0x55));
-    quint8 len = 0x02;
-    packet.append(static_cast<char>(len));
-    quint8 code = 0x06;
-    packet.append(static_cast<char>(code));
-    packet.append(static_cast<char>(data));
-    quint8 checksum = (len + code + data) & 0xFF;
-    packet.append(static_cast<char>(checksum));
-
-    qint64 bytesWritten = serial.write(packet);
-    serial.flush();
-
-    qDebug() << "Biolight ayar paketi gönderildi:" << packet.toHex(' ')
-             << "(" << bytesWritten << "bytes)";
+    // Yazma işlemi portun sahibi olan acquisition thread'inde yapılır
+    AcquisitionWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, data]() { worker->sendSetting(data); },
+                              Qt::QueuedConnection);
 }
@@ -2,38 +2,70 @@
 #define READER_H
 
 #include <QObject>
-#include <QSerialPort>
-#include <QByteArray>
+#include <QThread>
 #include <QVariantList>
-#include <QDateTime>
-#include <QQueue>
-
-struct WaveformPoint {
-    double value;
-    qint64 timestamp; // milliseconds since epoch
-    WaveformPoint() : value(0), timestamp(0) {}
-    WaveformPoint(double v, qint64 t) : value(v), timestamp(t) {}
-};
+#include "acquisitionworker.h"
+#include "notificationscheduler.h"
+#include "samplering.h"
+#include "waveformhistory.h"
+#include "waveformmodel.h"
+#include "waveformstatistics.h"
+
+class WaveformStore;
 
 class Reader : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(int spo2 READ spo2 NOTIFY spo2Changed)
     Q_PROPERTY(int pr READ pr NOTIFY prChanged)
-    Q_PROPERTY(QVariantList waveform READ waveform NOTIFY waveformChanged)
+    Q_PROPERTY(bool probeOff READ probeOff NOTIFY statusChanged)
+    Q_PROPERTY(double perfusionIndex READ perfusionIndex NOTIFY statusChanged)
+    Q_PROPERTY(WaveformModel *waveformModel READ waveformModel CONSTANT)
+    Q_PROPERTY(WaveformStatistics *statistics READ statistics CONSTANT)
+    Q_PROPERTY(WaveformHistory *history READ history CONSTANT)
     Q_PROPERTY(bool frozen READ frozen NOTIFY frozenChanged)
+    Q_PROPERTY(int retentionSeconds READ retentionSeconds WRITE setRetentionSeconds NOTIFY retentionSecondsChanged)
 
 public:
-    explicit Reader(const QString &portName, QObject *parent = nullptr);
+    // ioThread: porta ait AcquisitionWorker'ın çalışacağı (paylaşılan) G/Ç thread'i
+    // scheduler: tüm cihazların paylaştığı kare zamanlayıcısı
+    Reader(const QString &portName, QThread *ioThread, NotificationScheduler *scheduler,
+           QObject *parent = nullptr);
     ~Reader() override;
 
     int spo2() const { return m_spo2; }
     int pr() const { return m_pr; }
-    QVariantList waveform() const { return m_waveform; }
+    bool probeOff() const { return m_probeOff; }
+    // Perfüzyon indeksi (%), bilinmiyorsa -1
+    double perfusionIndex() const { return m_perfusion < 0 ? -1.0 : m_perfusion / 100.0; }
+    int statusFlags() const { return m_statusFlags; }
+    WaveformModel *waveformModel() const { return m_waveformModel; }
+    // Son pencere üzerinde min/max/ortalama/std; kare başına en fazla bir kez güncellenir
+    WaveformStatistics *statistics() const { return m_statistics; }
+    // Yakınlaştırılabilir uzun süreli geçmiş (min/max piramidi, varsayılan 1 saat)
+    WaveformHistory *history() const { return m_history; }
     bool frozen() const { return m_frozen; }
 
+    // Waveform geçmişinin saklama süresi (varsayılan 20 s)
+    int retentionSeconds() const { return m_waveformBuffer.retentionSeconds(); }
+    void setRetentionSeconds(int seconds);
+
+    // Kopyasız waveform görüntüsü (PDF ve diğer C++ tüketicileri için)
+    SampleSpan<quint8> waveformSnapshot(double seconds) const { return m_waveformBuffer.lastSeconds(seconds); }
+
+    // Yeniden senkronizasyon sırasında atılan bayt sayısı (gürültü göstergesi)
+    qint64 discardedBytes() const { return static_cast<qint64>(m_worker->discardedBytes()); }
+    qint64 checksumErrors() const { return static_cast<qint64>(m_worker->checksumErrors()); }
+    // UI yetişemediği için acquisition thread'inde düşürülen örnek sayısı
+    qint64 droppedSamples() const { return static_cast<qint64>(m_worker->droppedSamples()); }
+
+    QString portName() const { return m_portName; }
+
     Q_INVOKABLE QVariantList getLast20SecondsWaveform() const;
     Q_INVOKABLE QVariantList getLast20SecondsTimestamps() const;
+    // Aynı 20 saniye, WaveformCodec çerçevesi olarak (başlangıç zamanı + hız + paketli örnekler);
+    // dışa aktarım ve ağ akışı için QVariantList'ten çok daha küçük
+    Q_INVOKABLE QByteArray getLast20SecondsWaveformPacked() const;
     Q_INVOKABLE bool setResponseTime(int seconds);
 
     // Freeze/Unfreeze
@@ -41,34 +73,70 @@ public:
     Q_INVOKABLE void unfreeze();
     Q_INVOKABLE void toggleFreeze();
 
+    // Ham seri veri kaydı (directory altında port açılışı başına bir oturum)
+    Q_INVOKABLE void startCapture(const QString &directory);
+    Q_INVOKABLE void stopCapture();
+    // "replay:<dizin>" portları için oynatma hızı (1 = gerçek zaman, <= 0 = azami)
+    Q_INVOKABLE void setReplaySpeed(double speed);
+
+    // Pleth filtre zinciri G/Ç thread'inde uygulanır; decimation saklama halkasının
+    // örnekleme hızını da değiştirir
+    void setFilterConfig(const PlethFilterConfig &config);
+
+    // Uzun süreli arşiv: pleth örnekleri chunkSeconds'lık parçalar halinde depolama
+    // thread'ine devredilir (yalnızca aktif hasta varken)
+    void setWaveformStore(WaveformStore *store, double chunkSeconds);
+    // patientId <= 0: arşivleme durur; değişimde yarım parça önceki hastaya yazılır
+    void setPatientId(int patientId);
+    int patientId() const { return m_patientId; }
+
 signals:
     void spo2Changed();
     void prChanged();
+    void statusChanged();
     void waveformChanged();
     void frozenChanged();
+    void retentionSecondsChanged();
 
 private slots:
-    void readSerialData();
-    void processPacket(const QByteArray &packet);
+    void drainSamples(); // Acquisition kuyruğunu kare başına bir kez boşalt
+    void onFrame(); // Birleştirilmiş değişiklik bildirimlerini yayınla
+    void onPortStateChanged(bool open);
 
 private:
-    void cleanOldData(); // 20 saniyeden eski verileri temizle
-    void updateDisplayWaveform(); // Ekran için waveform güncelle
+    void updateDisplayWaveform(); // Yeni örnekleri ekran modeline aktar
     void sendSettingToBiolight(quint8 data); // Biolight modülüne ayar gönder
-
-    bool openSerialPort();
-    void closeSerialPort();
+    void archiveSample(quint8 value, qint64 timestamp);
+    void flushArchiveChunk(); // Biriken parçayı depolama thread'ine gönder
 
 private:
-    QSerialPort serial;
-    QByteArray buffer;
+    // Seri G/Ç ve paket çözme paylaşılan G/Ç thread'inde
+    AcquisitionWorker *m_worker;
+    NotificationScheduler *m_scheduler;
+    int m_dirty = 0; // kare başına birleştirilen bildirim kanalları
+    bool m_unfreezePending = false;
+
     int m_spo2 = -1;
     int m_pr = -1;
-    QVariantList m_waveform; // Ekran için (son MAX_DISPLAY_POINTS nokta)
+    bool m_probeOff = false;
+    int m_perfusion = -1;   // 0.01 % birimi
+    int m_statusFlags = -1;
+    WaveformModel *m_waveformModel; // Ekran için (son MAX_DISPLAY_POINTS nokta), artımlı
+    qint64 m_displayCursor = 0;     // modele aktarılan son örneğin halka imleci
+    WaveformStatistics *m_statistics; // Örnek başına O(1) güncellenen kayan pencere istatistikleri
+    WaveformHistory *m_history;       // Dakikalar-saatler ölçeğinde geçmiş (ekran halkasından bağımsız)
+
+    // Sabit kapasiteli örnek halkası; zaman damgaları örnekleme hızından türetilir
+    static const int SAMPLE_RATE_HZ = 50; // Modül varsayılan frekansı
+    SampleRing<quint8> m_waveformBuffer; // Saklama süresi kadar waveform geçmişi
+    static const int MAX_DISPLAY_POINTS = 500; // Ekranda gösterilecek nokta sayısı (50 Hz'de 10 s, eksen etiketleri)
 
-    // Yeni buffer sistemi - timestamp'li
-    QQueue<WaveformPoint> m_waveformBuffer; // Tüm waveform geçmişi
-    static const int MAX_DISPLAY_POINTS = 200; // Ekranda gösterilecek nokta sayısı
+    // Arşiv parçası (GUI thread'inde biriktirilir, dosya G/Ç'si depolama thread'inde)
+    WaveformStore *m_store = nullptr;
+    int m_patientId = -1;
+    int m_chunkSamples = 0;
+    QByteArray m_chunk;
+    qint64 m_chunkStartMs = 0;
 
     // Freeze durumu
     bool m_frozen = false;
@@ -0,0 +1,159 @@
+#ifndef SAMPLERING_H
+#define SAMPLERING_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <cmath>
+
+// Halkadaki ardışık örneklerin sahiplenmeyen, bitişik görünümü.
+// Zaman damgaları saklanmaz: son örneğin zamanı + örnekleme hızından türetilir.
+// Görünüm, halkaya bir sonraki append() çağrısına kadar geçerlidir.
+template <typename T>
+struct SampleSpan {
+    const T *data = nullptr;
+    int size = 0;
+    qint64 lastTimestamp = 0; // son örneğin zamanı (milliseconds since epoch)
+    double sampleRate = 0.0;  // Hz
+
+    bool isEmpty() const { return size == 0; }
+    const T &operator[](int i) const { return data[i]; }
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+
+    qint64 timestampAt(int i) const
+    {
+        return lastTimestamp - static_cast<qint64>(std::llround((size - 1 - i) * 1000.0 / sampleRate));
+    }
+};
+
+// Önceden ayrılmış, sabit kapasiteli örnek halkası.
+// Her örnek iki kez yazılır (i ve i + capacity) böylece son N örnek her zaman
+// bitişik bir bellek bloğudur; ekleme ve en eskiyi atma O(1)'dir.
+template <typename T>
+class SampleRing
+{
+public:
+    explicit SampleRing(double sampleRate = 50.0, int retentionSeconds = 20)
+        : m_sampleRate(sampleRate)
+    {
+        setRetentionSeconds(retentionSeconds);
+    }
+
+    double sampleRate() const { return m_sampleRate; }
+    int retentionSeconds() const { return m_retentionSeconds; }
+    int capacity() const { return m_capacity; }
+    int size() const { return static_cast<int>(qMin<qint64>(m_written - m_clearedAt, m_capacity)); }
+    bool isEmpty() const { return size() == 0; }
+    qint64 totalWritten() const { return m_written; }
+    qint64 lastTimestamp() const { return m_lastTimestamp; }
+
+    // Saklama süresini değiştirir; sığan en yeni örnekler korunur (yapılandırma anında çağrılır)
+    void setRetentionSeconds(int seconds)
+    {
+        seconds = qMax(1, seconds);
+        setCapacity(static_cast<int>(std::ceil(seconds * m_sampleRate)));
+        m_retentionSeconds = seconds;
+    }
+
+    // Örnekleme hızını değiştirir (ör. decimation); farklı hızdaki eski örnekler atılır
+    void setSampleRate(double sampleRate)
+    {
+        if (sampleRate <= 0.0 || sampleRate == m_sampleRate)
+            return;
+        m_sampleRate = sampleRate;
+        clear();
+        setCapacity(static_cast<int>(std::ceil(m_retentionSeconds * m_sampleRate)));
+    }
+
+    // Kapasiteyi doğrudan örnek sayısı olarak ayarlar
+    void setCapacity(int capacity)
+    {
+        capacity = qMax(1, capacity);
+        if (capacity == m_capacity)
+            return;
+
+        // Mutlak indeks k her zaman k % capacity konumunda tutulur; totalWritten değişmez
+        const SampleSpan<T> keep = last(capacity);
+        const qint64 first = m_written - keep.size;
+        QVector<T> storage(2 * capacity);
+        for (int i = 0; i < keep.size; ++i) {
+            const int index = static_cast<int>((first + i) % capacity);
+            storage[index] = keep.data[i];
+            storage[index + capacity] = keep.data[i];
+        }
+
+        m_storage.swap(storage);
+        m_capacity = capacity;
+        m_clearedAt = first; // taşınmayan eski örnekler geçersiz
+        m_retentionSeconds = qMax(1, static_cast<int>(capacity / m_sampleRate));
+    }
+
+    void append(T value, qint64 timestamp)
+    {
+        const int index = static_cast<int>(m_written % m_capacity);
+        T *storage = m_storage.data();
+        storage[index] = value;
+        storage[index + m_capacity] = value;
+        ++m_written;
+        m_lastTimestamp = timestamp;
+    }
+
+    // En eski count örneği geçersiz sayar (O(1))
+    void dropOldest(int count)
+    {
+        m_clearedAt = m_written - qMax(0, size() - count);
+    }
+
+    // İçeriği boşaltır; totalWritten imleci monoton kalır
+    void clear()
+    {
+        m_clearedAt = m_written;
+    }
+
+    // En yeni count örnek (count <= 0 ya da fazlaysa tümü), eskiden yeniye
+    SampleSpan<T> last(int count = -1) const
+    {
+        SampleSpan<T> span;
+        span.sampleRate = m_sampleRate;
+        span.lastTimestamp = m_lastTimestamp;
+
+        const int available = size();
+        span.size = (count <= 0 || count > available) ? available : count;
+        if (span.size == 0)
+            return span;
+
+        const int start = static_cast<int>((m_written - span.size) % m_capacity);
+        span.data = m_storage.constData() + start;
+        return span;
+    }
+
+    // cursor (totalWritten değeri) sonrasında eklenen örnekler; halkadan taşanlar atlanır
+    SampleSpan<T> since(qint64 cursor) const
+    {
+        const qint64 pending = m_written - cursor;
+        if (pending <= 0) {
+            SampleSpan<T> empty;
+            empty.lastTimestamp = m_lastTimestamp;
+            empty.sampleRate = m_sampleRate;
+            return empty;
+        }
+        return last(static_cast<int>(qMin<qint64>(pending, m_capacity)));
+    }
+
+    // Son seconds saniyelik pencere
+    SampleSpan<T> lastSeconds(double seconds) const
+    {
+        return last(qMax(1, static_cast<int>(std::llround(seconds * m_sampleRate))));
+    }
+
+private:
+    QVector<T> m_storage; // 2 * capacity (aynalanmış)
+    int m_capacity = 0;
+    int m_retentionSeconds = 0;
+    qint64 m_written = 0;   // şimdiye kadar eklenen toplam örnek (monoton imleç)
+    qint64 m_clearedAt = 0; // bu imleçten önceki örnekler geçersiz (clear/yeniden boyutlandırma)
+    qint64 m_lastTimestamp = 0;
+    double m_sampleRate;
+};
+
+#endif // SAMPLERING_H
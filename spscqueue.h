@@ -0,0 +1,81 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+
+// Tek üretici / tek tüketici için kilitsiz, sabit kapasiteli kuyruk.
+// Üretici yalnızca tryPush, tüketici yalnızca tryPop/drain çağırmalıdır.
+template <typename T, quint32 Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity 2'nin kuvveti olmalı");
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Kuyruk doluysa false döner (geri basınç), eleman yazılmaz
+    bool tryPush(const T &item)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == Capacity) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == Capacity)
+                return false;
+        }
+        m_items[tail & Mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &item)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return false;
+        }
+        item = m_items[head & Mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Mevcut tüm elemanları tek seferde tüketir; fn(const T &) her eleman için çağrılır
+    template <typename Fn>
+    int drain(Fn &&fn)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        for (quint32 i = head; i != tail; ++i)
+            fn(m_items[i & Mask]);
+        m_head.store(tail, std::memory_order_release);
+        m_tailCache = tail;
+        return static_cast<int>(tail - head);
+    }
+
+    // Yaklaşık doluluk (her iki taraftan da okunabilir)
+    int size() const
+    {
+        return static_cast<int>(m_tail.load(std::memory_order_acquire)
+                                - m_head.load(std::memory_order_acquire));
+    }
+
+    static constexpr int capacity() { return static_cast<int>(Capacity); }
+
+private:
+    static constexpr quint32 Mask = Capacity - 1;
+    static constexpr int CacheLine = 64;
+
+    // Üretici ve tüketici indeksleri ayrı önbellek satırlarında (false sharing önlenir)
+    alignas(CacheLine) std::atomic<quint32> m_head{0};
+    quint32 m_tailCache = 0;   // tüketicinin gördüğü son tail
+    alignas(CacheLine) std::atomic<quint32> m_tail{0};
+    quint32 m_headCache = 0;   // üreticinin gördüğü son head
+    alignas(CacheLine) T m_items[Capacity];
+};
+
+#endif // SPSCQUEUE_H
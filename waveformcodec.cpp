@@ -0,0 +1,314 @@
+#include "waveformcodec.h"
+#include <QtEndian>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CODEC_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CODEC_SIMD_NEON 1
+#endif
+
+namespace {
+
+constexpr char FrameMagic[4] = {'P', 'W', '1', '\0'};
+
+inline quint8 zigzag(quint8 current, quint8 previous)
+{
+    const int delta = static_cast<qint8>(static_cast<quint8>(current - previous));
+    // Sola kaydırma işaretsiz değerde (negatif int'i kaydırmak C++17'de tanımsız)
+    return static_cast<quint8>((static_cast<unsigned>(delta) << 1) ^ static_cast<unsigned>(delta >> 7));
+}
+
+inline quint8 unzigzag(quint8 z)
+{
+    return static_cast<quint8>((z >> 1) ^ -(z & 1));
+}
+
+int packedBytes(int count, int width)
+{
+    return (count * width + 7) / 8;
+}
+
+// 8 değer * W bit = tam W bayt; gruplar tek 64 bit kelimeyle yazılır/okunur
+template <int W>
+void packGroups(const quint8 *values, int groups, quint8 *out)
+{
+    for (int g = 0; g < groups; ++g, values += 8, out += W) {
+        quint64 word = 0;
+        for (int i = 0; i < 8; ++i)
+            word |= static_cast<quint64>(values[i]) << (i * W);
+        word = qToLittleEndian(word); // ilk W bayt düşük bitler; biçim host'tan bağımsız
+        std::memcpy(out, &word, W);
+    }
+}
+
+template <int W>
+void unpackGroups(const quint8 *in, int groups, quint8 *values)
+{
+    constexpr quint64 mask = (1u << W) - 1;
+    for (int g = 0; g < groups; ++g, in += W, values += 8) {
+        quint64 word = 0;
+        std::memcpy(&word, in, W);
+        word = qFromLittleEndian(word);
+        for (int i = 0; i < 8; ++i)
+            values[i] = static_cast<quint8>((word >> (i * W)) & mask);
+    }
+}
+
+void packBits(const quint8 *values, int count, int width, quint8 *out)
+{
+    if (width == 8) {
+        std::memcpy(out, values, static_cast<size_t>(count));
+        return;
+    }
+
+    const int groups = count / 8;
+    switch (width) {
+    case 1: packGroups<1>(values, groups, out); break;
+    case 2: packGroups<2>(values, groups, out); break;
+    case 3: packGroups<3>(values, groups, out); break;
+    case 4: packGroups<4>(values, groups, out); break;
+    case 5: packGroups<5>(values, groups, out); break;
+    case 6: packGroups<6>(values, groups, out); break;
+    case 7: packGroups<7>(values, groups, out); break;
+    default: return;
+    }
+
+    // Sekize tamamlanmayan kuyruk
+    out += groups * width;
+    quint32 accumulator = 0;
+    int bits = 0;
+    for (int i = groups * 8; i < count; ++i) {
+        accumulator |= static_cast<quint32>(values[i]) << bits;
+        bits += width;
+        while (bits >= 8) {
+            *out++ = static_cast<quint8>(accumulator);
+            accumulator >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0)
+        *out = static_cast<quint8>(accumulator);
+}
+
+void unpackBits(const quint8 *in, int count, int width, quint8 *values)
+{
+    if (width == 0) {
+        std::memset(values, 0, static_cast<size_t>(count));
+        return;
+    }
+    if (width == 8) {
+        std::memcpy(values, in, static_cast<size_t>(count));
+        return;
+    }
+
+    const int groups = count / 8;
+    switch (width) {
+    case 1: unpackGroups<1>(in, groups, values); break;
+    case 2: unpackGroups<2>(in, groups, values); break;
+    case 3: unpackGroups<3>(in, groups, values); break;
+    case 4: unpackGroups<4>(in, groups, values); break;
+    case 5: unpackGroups<5>(in, groups, values); break;
+    case 6: unpackGroups<6>(in, groups, values); break;
+    case 7: unpackGroups<7>(in, groups, values); break;
+    default: return;
+    }
+
+    in += groups * width;
+    const quint32 mask = (1u << width) - 1;
+    quint32 accumulator = 0;
+    int bits = 0;
+    for (int i = groups * 8; i < count; ++i) {
+        if (bits < width) {
+            accumulator |= static_cast<quint32>(*in++) << bits;
+            bits += 8;
+        }
+        values[i] = static_cast<quint8>(accumulator & mask);
+        accumulator >>= width;
+        bits -= width;
+    }
+}
+
+// Zigzag çözme + önek toplamı (mod 256); son örneği döndürür
+quint8 reconstruct(const quint8 *zigzags, int count, quint8 previous, quint8 *out)
+{
+    int i = 0;
+#if defined(CODEC_SIMD_SSE2)
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i carry = _mm_set1_epi8(static_cast<char>(previous));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i *>(zigzags + i));
+        const __m128i half = _mm_and_si128(_mm_srli_epi16(z, 1), low7);
+        const __m128i sign = _mm_sub_epi8(zero, _mm_and_si128(z, one));
+        __m128i d = _mm_xor_si128(half, sign);
+        // 16 şeritte kaydırmalı önek toplamı (log2(16) = 4 adım)
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 1));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 2));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi8(d, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), d);
+        // Son baytı tüm şeritlere yay
+        __m128i last = _mm_srli_si128(d, 15);
+        last = _mm_unpacklo_epi8(last, last);
+        last = _mm_unpacklo_epi16(last, last);
+        carry = _mm_shuffle_epi32(last, 0);
+    }
+    if (i > 0)
+        previous = out[i - 1];
+#elif defined(CODEC_SIMD_NEON)
+    const uint8x16_t one = vdupq_n_u8(1);
+    const uint8x16_t zero = vdupq_n_u8(0);
+    uint8x16_t carry = vdupq_n_u8(previous);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t z = vld1q_u8(zigzags + i);
+        const uint8x16_t sign = vsubq_u8(zero, vandq_u8(z, one));
+        uint8x16_t d = veorq_u8(vshrq_n_u8(z, 1), sign);
+        d = vaddq_u8(d, vextq_u8(zero, d, 15));
+        d = vaddq_u8(d, vextq_u8(zero, d, 14));
+        d = vaddq_u8(d, vextq_u8(zero, d, 12));
+        d = vaddq_u8(d, vextq_u8(zero, d, 8));
+        d = vaddq_u8(d, carry);
+        vst1q_u8(out + i, d);
+        carry = vdupq_n_u8(vgetq_lane_u8(d, 15));
+    }
+    if (i > 0)
+        previous = out[i - 1];
+#endif
+    for (; i < count; ++i) {
+        previous = static_cast<quint8>(previous + unzigzag(zigzags[i]));
+        out[i] = previous;
+    }
+    return previous;
+}
+
+} // namespace
+
+namespace WaveformCodec {
+
+int maxEncodedSize(int count)
+{
+    if (count <= 0)
+        return 0;
+    const int blocks = (count - 1 + BlockSize - 1) / BlockSize;
+    return 1 + blocks + (count - 1);
+}
+
+int encode(const quint8 *samples, int count, quint8 *out)
+{
+    if (count <= 0)
+        return 0;
+
+    quint8 *start = out;
+    *out++ = samples[0];
+
+    quint8 zigzags[BlockSize];
+    for (int first = 1; first < count; first += BlockSize) {
+        const int n = qMin(BlockSize, count - first);
+        quint8 bitsUsed = 0;
+        for (int i = 0; i < n; ++i) {
+            zigzags[i] = zigzag(samples[first + i], samples[first + i - 1]);
+            bitsUsed |= zigzags[i];
+        }
+
+        int width = 0;
+        while (width < 8 && (bitsUsed >> width))
+            ++width;
+
+        *out++ = static_cast<quint8>(width);
+        if (width > 0) {
+            packBits(zigzags, n, width, out);
+            out += packedBytes(n, width);
+        }
+    }
+    return static_cast<int>(out - start);
+}
+
+QByteArray encode(const quint8 *samples, int count)
+{
+    QByteArray encoded(maxEncodedSize(count), Qt::Uninitialized);
+    encoded.resize(encode(samples, count, reinterpret_cast<quint8 *>(encoded.data())));
+    return encoded;
+}
+
+bool decode(const quint8 *data, int size, quint8 *out, int count)
+{
+    if (count <= 0)
+        return true;
+    if (size < 1)
+        return false;
+
+    const quint8 *end = data + size;
+    quint8 previous = *data++;
+    out[0] = previous;
+
+    alignas(16) quint8 zigzags[BlockSize];
+    for (int first = 1; first < count; first += BlockSize) {
+        const int n = qMin(BlockSize, count - first);
+        if (data >= end)
+            return false;
+        const int width = *data++;
+        if (width > 8)
+            return false;
+        const int bytes = packedBytes(n, width);
+        if (end - data < bytes)
+            return false;
+
+        unpackBits(data, n, width, zigzags);
+        data += bytes;
+        previous = reconstruct(zigzags, n, previous, out + first);
+    }
+    return true;
+}
+
+QByteArray packFrame(const quint8 *samples, int count, qint64 startMs, double sampleRate)
+{
+    // Başlık alanları little-endian yazılır (akış gibi host'tan bağımsız)
+    FrameHeader header;
+    std::memcpy(header.magic, FrameMagic, sizeof(header.magic));
+    header.sampleCount = qToLittleEndian(static_cast<quint32>(qMax(0, count)));
+    header.sampleRate = qToLittleEndian(static_cast<float>(sampleRate));
+    header.reserved = 0;
+    header.startMs = qToLittleEndian(startMs);
+
+    QByteArray frame(static_cast<int>(sizeof(header)) + maxEncodedSize(count), Qt::Uninitialized);
+    std::memcpy(frame.data(), &header, sizeof(header));
+    const int encoded = encode(samples, count, reinterpret_cast<quint8 *>(frame.data() + sizeof(header)));
+    frame.resize(static_cast<int>(sizeof(header)) + encoded);
+    return frame;
+}
+
+bool unpackFrame(const QByteArray &frame, QByteArray &samples, qint64 *startMs, double *sampleRate)
+{
+    samples.clear();
+    if (frame.size() < static_cast<int>(sizeof(FrameHeader)))
+        return false;
+
+    FrameHeader header;
+    std::memcpy(&header, frame.constData(), sizeof(header));
+    if (std::memcmp(header.magic, FrameMagic, sizeof(header.magic)) != 0)
+        return false;
+    header.sampleCount = qFromLittleEndian(header.sampleCount);
+    header.sampleRate = qFromLittleEndian(header.sampleRate);
+    header.startMs = qFromLittleEndian(header.startMs);
+
+    QByteArray decoded(static_cast<int>(header.sampleCount), Qt::Uninitialized);
+    if (!decode(reinterpret_cast<const quint8 *>(frame.constData() + sizeof(header)),
+                frame.size() - static_cast<int>(sizeof(header)),
+                reinterpret_cast<quint8 *>(decoded.data()), decoded.size())) {
+        return false;
+    }
+
+    samples = decoded;
+    if (startMs)
+        *startMs = header.startMs;
+    if (sampleRate)
+        *sampleRate = header.sampleRate;
+    return true;
+}
+
+} // namespace WaveformCodec
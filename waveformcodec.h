@@ -0,0 +1,49 @@
+#ifndef WAVEFORMCODEC_H
+#define WAVEFORMCODEC_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+// 8 bit pleth örnek blokları için kayıpsız kodek: delta + zigzag + blok başına
+// en küçük bit genişliğiyle paketleme. Arşiv, dışa aktarım ve akış yolları aynı
+// biçimi kullanır; zaman damgaları saklanmaz (başlangıç zamanı + örnekleme hızı).
+//
+// Akış: [ilk örnek] + her BlockSize delta için [genişlik (0-8)] + paketlenmiş bitler.
+// Deltalar 8 bit modüler aritmetikle alınır (x[i] - x[i-1] mod 256, işaretli), bu
+// yüzden zigzag sonrası her delta en fazla 8 bittir ve çözme bayt toplamasıdır.
+// Bitler LSB-önce paketlenir; blok sınırları bayta hizalıdır. Çok baytlı değerler
+// (paket kelimeleri, çerçeve başlığı) little-endian'dır, biçim host'a bağlı değildir.
+//
+// Çözücü: bit açma (genişlik 0 ve 8 için kopya/doldurma), ardından zigzag çözme ve
+// önek toplamı 16 baytlık SSE2/NEON vektörleriyle yapılır; skaler yedek yol aynı sonucu verir.
+namespace WaveformCodec {
+
+constexpr int BlockSize = 128; // blok başına delta
+
+// count örneklik bir akışın en kötü durumda kaplayacağı bayt
+int maxEncodedSize(int count);
+
+// out en az maxEncodedSize(count) bayt olmalı; yazılan bayt sayısını döndürür
+int encode(const quint8 *samples, int count, quint8 *out);
+QByteArray encode(const quint8 *samples, int count);
+
+// count örneği out'a çözer; akış kısa ya da bozuksa false
+bool decode(const quint8 *data, int size, quint8 *out, int count);
+
+// Kendini tanımlayan çerçeve (dışa aktarım/akış): 24 baytlık başlık + akış
+struct FrameHeader {
+    char magic[4];        // "PW1\0"
+    quint32 sampleCount;
+    float sampleRate;     // Hz
+    quint32 reserved;
+    qint64 startMs;       // ilk örneğin zamanı (milliseconds since epoch)
+};
+static_assert(sizeof(FrameHeader) == 24, "FrameHeader 24 bayt olmalı");
+
+QByteArray packFrame(const quint8 *samples, int count, qint64 startMs, double sampleRate);
+// Çerçeveyi çözer; geçersizse false ve samples boş
+bool unpackFrame(const QByteArray &frame, QByteArray &samples, qint64 *startMs = nullptr, double *sampleRate = nullptr);
+
+} // namespace WaveformCodec
+
+#endif // WAVEFORMCODEC_H
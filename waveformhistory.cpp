@@ -0,0 +1,44 @@
+#include "waveformhistory.h"
+#include <QDebug>
+
+WaveformHistory::WaveformHistory(double sampleRate, double historySeconds, QObject *parent)
+    : QObject(parent)
+    , m_pyramid(sampleRate, historySeconds)
+{
+}
+
+void WaveformHistory::setHistorySeconds(double seconds)
+{
+    if (seconds <= 0.0 || qFuzzyCompare(seconds, m_pyramid.historySeconds()))
+        return;
+
+    m_pyramid.setHistorySeconds(seconds);
+    qDebug() << "WaveformHistory: geçmiş" << seconds << "saniye," << m_pyramid.levelCount() << "seviye";
+    emit historySecondsChanged();
+    emit samplesAppended();
+}
+
+void WaveformHistory::setSampleRate(double sampleRate)
+{
+    if (sampleRate <= 0.0 || qFuzzyCompare(sampleRate, m_pyramid.sampleRate()))
+        return;
+
+    m_pyramid.setSampleRate(sampleRate);
+    emit samplesAppended();
+}
+
+void WaveformHistory::clear()
+{
+    m_pyramid.clear();
+    m_pending = 0;
+    emit samplesAppended();
+}
+
+void WaveformHistory::publish()
+{
+    if (m_pending == 0)
+        return;
+
+    m_pending = 0;
+    emit samplesAppended();
+}
@@ -0,0 +1,43 @@
+#ifndef WAVEFORMHISTORY_H
+#define WAVEFORMHISTORY_H
+
+#include <QObject>
+#include "waveformpyramid.h"
+
+// Uzun süreli (dakikalar-saatler) waveform geçmişi. Ekran halkasından (son birkaç
+// saniye) bağımsızdır; min/max piramidi sayesinde herhangi bir zaman aralığı
+// piksel sütunu başına bir min/max çiftiyle çizilebilir.
+// Örnekler GUI thread'inde, kuyruk boşaltılırken eklenir; samplesAppended()
+// kare başına en fazla bir kez (publish) yayınlanır.
+class WaveformHistory : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double historySeconds READ historySeconds WRITE setHistorySeconds NOTIFY historySecondsChanged)
+    Q_PROPERTY(double availableSeconds READ availableSeconds NOTIFY samplesAppended)
+
+public:
+    explicit WaveformHistory(double sampleRate, double historySeconds = 3600.0, QObject *parent = nullptr);
+
+    double historySeconds() const { return m_pyramid.historySeconds(); }
+    void setHistorySeconds(double seconds);
+    double availableSeconds() const { return m_pyramid.availableSeconds(); }
+    void setSampleRate(double sampleRate);
+
+    const WaveformPyramid<quint8> &pyramid() const { return m_pyramid; }
+
+    void append(quint8 value, qint64 timestamp) { m_pyramid.append(value, timestamp); ++m_pending; }
+    void clear();
+
+    // Son yayından beri örnek eklendiyse samplesAppended() yayınlar
+    void publish();
+
+signals:
+    void samplesAppended();
+    void historySecondsChanged();
+
+private:
+    WaveformPyramid<quint8> m_pyramid;
+    int m_pending = 0;
+};
+
+#endif // WAVEFORMHISTORY_H
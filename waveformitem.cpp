@@ -0,0 +1,446 @@
+#include "waveformitem.h"
+#include <QSGGeometryNode>
+#include <QSGFlatColorMaterial>
+#include <QSGSimpleRectNode>
+
+namespace {
+
+// Izgara, silme çubuğu ve iz düğümlerini bir arada tutan kök düğüm
+class WaveformNode : public QSGNode
+{
+public:
+    WaveformNode()
+    {
+        grid = createLineNode(QSGGeometry::StaticPattern);
+        sweepBar = new QSGSimpleRectNode();
+        trace = createLineNode(QSGGeometry::DynamicPattern);
+
+        appendChildNode(grid);
+        appendChildNode(sweepBar);
+        appendChildNode(trace);
+    }
+
+    static QSGGeometryNode *createLineNode(QSGGeometry::DataPattern pattern)
+    {
+        auto *node = new QSGGeometryNode();
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawLines);
+        geometry->setVertexDataPattern(pattern);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+
+        node->setMaterial(new QSGFlatColorMaterial());
+        node->setFlag(QSGNode::OwnsMaterial);
+        return node;
+    }
+
+    QSGGeometryNode *grid;
+    QSGSimpleRectNode *sweepBar;
+    QSGGeometryNode *trace;
+};
+
+// Yatay ve dikey ızgara çizgileri (statik)
+void buildGridGeometry(QSGGeometry *geometry, const QSizeF &size, int rows, int columns)
+{
+    const float w = static_cast<float>(size.width());
+    const float h = static_cast<float>(size.height());
+
+    geometry->allocate(2 * ((rows - 1) + (columns - 1)));
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+
+    int v = 0;
+    for (int i = 1; i < rows; ++i) {
+        const float y = i * h / rows;
+        vertices[v++].set(0.0f, y);
+        vertices[v++].set(w, y);
+    }
+    for (int i = 1; i < columns; ++i) {
+        const float x = i * w / columns;
+        vertices[v++].set(x, 0.0f);
+        vertices[v++].set(x, h);
+    }
+}
+
+} // namespace
+
+// --- SweepTraceBuilder ---
+
+void SweepTraceBuilder::reset(QSGGeometry *geometry, int slots, const QSizeF &size, int gapSlots)
+{
+    m_slots = qMax(2, slots);
+    m_gapSlots = qBound(0, gapSlots, m_slots - 2);
+    m_slot = 0;
+    m_stepX = static_cast<float>(size.width() / (m_slots - 1));
+    m_height = static_cast<float>(size.height());
+    m_lastY = m_height;
+    m_hasLast = false;
+
+    // Her yuva bir segment (iki köşe); başlangıçta tümü dejenere (çizilmez)
+    geometry->allocate(2 * m_slots);
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    for (int slot = 0; slot < m_slots; ++slot)
+        collapse(vertices, slot);
+}
+
+void SweepTraceBuilder::append(QSGGeometry *geometry, const float *values, int count)
+{
+    if (m_slots == 0 || count <= 0)
+        return;
+
+    // Bir turdan fazlası zaten üzerine yazılacak; yalnızca en yeni tur çizilir
+    if (count > m_slots) {
+        values += count - m_slots;
+        count = m_slots;
+    }
+
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i < count; ++i) {
+        const float x = m_slot * m_stepX;
+        const float y = yFor(values[i]);
+
+        QSGGeometry::Point2D &from = vertices[2 * m_slot];
+        QSGGeometry::Point2D &to = vertices[2 * m_slot + 1];
+        if (m_slot == 0 || !m_hasLast)
+            from.set(x, y); // sol kenar: önceki turla birleştirme
+        else
+            from.set(x - m_stepX, m_lastY);
+        to.set(x, y);
+
+        // İmlecin önündeki boşluğun en uzak yuvasını sil (diğerleri zaten silik)
+        if (m_gapSlots > 0)
+            collapse(vertices, (m_slot + m_gapSlots) % m_slots);
+
+        m_lastY = y;
+        m_hasLast = true;
+        m_slot = (m_slot + 1) % m_slots;
+    }
+}
+
+float SweepTraceBuilder::yFor(float value) const
+{
+    // 0-255 değerini yüksekliğe sığdır (Canvas ile aynı ölçek)
+    return m_height - qBound(0.0f, value / 255.0f, 1.0f) * m_height;
+}
+
+void SweepTraceBuilder::collapse(QSGGeometry::Point2D *vertices, int slot) const
+{
+    const float x = slot * m_stepX;
+    vertices[2 * slot].set(x, m_height);
+    vertices[2 * slot + 1].set(x, m_height);
+}
+
+// --- EnvelopeTraceBuilder ---
+
+void EnvelopeTraceBuilder::build(QSGGeometry *geometry, const WaveformPyramid<quint8> &pyramid,
+                                 double spanSeconds, double endSecondsAgo, const QSizeF &size)
+{
+    const int columns = qMax(1, static_cast<int>(size.width()));
+    const float height = static_cast<float>(size.height());
+    const float scale = height / 255.0f;
+
+    if (m_bins.size() != columns)
+        m_bins.resize(columns);
+    pyramid.envelopeSeconds(spanSeconds, endSecondsAgo, columns, m_bins.data());
+
+    if (geometry->vertexCount() != 2 * columns)
+        geometry->allocate(2 * columns);
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+
+    const EnvelopeBin<quint8> *previous = nullptr;
+    for (int c = 0; c < columns; ++c) {
+        const EnvelopeBin<quint8> &bin = m_bins.at(c);
+        const float x = c + 0.5f;
+        if (!bin.valid) {
+            // Veri yok: dejenere segment (çizilmez)
+            vertices[2 * c].set(x, height);
+            vertices[2 * c + 1].set(x, height);
+            previous = nullptr;
+            continue;
+        }
+
+        int lo = bin.minimum;
+        int hi = bin.maximum;
+        if (previous) {
+            // Komşu sütunla birleştir: iz kesintisiz görünür
+            lo = qMin(lo, static_cast<int>(previous->maximum));
+            hi = qMax(hi, static_cast<int>(previous->minimum));
+        }
+        // Düz bölgelerde de en az bir piksel yüksekliğinde segment
+        const float top = height - hi * scale - 0.5f;
+        const float bottom = height - lo * scale + 0.5f;
+        vertices[2 * c].set(x, bottom);
+        vertices[2 * c + 1].set(x, top);
+        previous = &bin;
+    }
+}
+
+// --- WaveformItem ---
+
+WaveformItem::WaveformItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void WaveformItem::setModel(WaveformModel *model)
+{
+    if (m_model == model)
+        return;
+
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+
+    m_model = model;
+    if (m_model) {
+        // Yeni örnekler geldiğinde yalnızca bir kare iste; çizim updatePaintNode'da
+        connect(m_model, &WaveformModel::samplesAppended, this, &QQuickItem::update);
+        connect(m_model, &QAbstractItemModel::modelReset, this, [this]() {
+            m_geometryDirty = true;
+            update();
+        });
+    }
+
+    m_geometryDirty = true;
+    update();
+    emit modelChanged();
+}
+
+void WaveformItem::setLineColor(const QColor &color)
+{
+    if (m_lineColor == color)
+        return;
+    m_lineColor = color;
+    m_materialDirty = true;
+    update();
+    emit lineColorChanged();
+}
+
+void WaveformItem::setGridColor(const QColor &color)
+{
+    if (m_gridColor == color)
+        return;
+    m_gridColor = color;
+    m_materialDirty = true;
+    update();
+    emit gridColorChanged();
+}
+
+void WaveformItem::setBackgroundColor(const QColor &color)
+{
+    if (m_backgroundColor == color)
+        return;
+    m_backgroundColor = color;
+    m_materialDirty = true;
+    update();
+    emit backgroundColorChanged();
+}
+
+void WaveformItem::setLineWidth(qreal width)
+{
+    if (qFuzzyCompare(m_lineWidth, width))
+        return;
+    m_lineWidth = width;
+    m_materialDirty = true;
+    update();
+    emit lineWidthChanged();
+}
+
+void WaveformItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_geometryDirty = true;
+        update();
+    }
+}
+
+void WaveformItem::buildGrid(QSGGeometry *geometry) const
+{
+    buildGridGeometry(geometry, size(), GRID_ROWS, GRID_COLUMNS);
+}
+
+QSGNode *WaveformItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    auto *node = static_cast<WaveformNode *>(oldNode);
+
+    if (!m_model || width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new WaveformNode();
+        m_geometryDirty = true;
+        m_materialDirty = true;
+    }
+
+    if (m_materialDirty) {
+        static_cast<QSGFlatColorMaterial *>(node->grid->material())->setColor(m_gridColor);
+        static_cast<QSGFlatColorMaterial *>(node->trace->material())->setColor(m_lineColor);
+        node->grid->geometry()->setLineWidth(1.0f);
+        node->trace->geometry()->setLineWidth(static_cast<float>(m_lineWidth));
+        node->sweepBar->setColor(m_backgroundColor);
+        node->grid->markDirty(QSGNode::DirtyMaterial | QSGNode::DirtyGeometry);
+        node->trace->markDirty(QSGNode::DirtyMaterial | QSGNode::DirtyGeometry);
+        m_materialDirty = false;
+    }
+
+    if (m_geometryDirty) {
+        // Statik ızgara yalnızca boyut değişince kurulur
+        buildGrid(node->grid->geometry());
+        node->grid->markDirty(QSGNode::DirtyGeometry);
+
+        // İz sıfırlanır ve modelde tutulan tüm örnekler yeniden yazılır
+        m_trace.reset(node->trace->geometry(), m_model->capacity(), size(), SWEEP_GAP_SLOTS);
+        m_cursor = m_model->writeCursor() - m_model->count();
+        m_geometryDirty = false;
+    }
+
+    // Yalnızca son kareden bu yana gelen örnekler (delta) yazılır
+    const SampleSpan<float> pending = m_model->since(m_cursor);
+    m_cursor = m_model->writeCursor();
+    if (!pending.isEmpty()) {
+        m_trace.append(node->trace->geometry(), pending.data, pending.size);
+        node->trace->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    // Silme çubuğu imlecin hemen önünde
+    const qreal stepX = width() / (m_trace.slots() - 1);
+    node->sweepBar->setRect(QRectF(m_trace.cursorSlot() * stepX, 0,
+                                   SWEEP_GAP_SLOTS * stepX, height()));
+
+    return node;
+}
+
+// --- WaveformHistoryItem ---
+
+namespace {
+
+class HistoryNode : public QSGNode
+{
+public:
+    HistoryNode()
+    {
+        grid = WaveformNode::createLineNode(QSGGeometry::StaticPattern);
+        trace = WaveformNode::createLineNode(QSGGeometry::DynamicPattern);
+        appendChildNode(grid);
+        appendChildNode(trace);
+    }
+
+    QSGGeometryNode *grid;
+    QSGGeometryNode *trace;
+};
+
+} // namespace
+
+WaveformHistoryItem::WaveformHistoryItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void WaveformHistoryItem::setHistory(WaveformHistory *history)
+{
+    if (m_history == history)
+        return;
+
+    if (m_history)
+        disconnect(m_history, nullptr, this, nullptr);
+
+    m_history = history;
+    if (m_history)
+        connect(m_history, &WaveformHistory::samplesAppended, this, &QQuickItem::update);
+
+    update();
+    emit historyChanged();
+}
+
+void WaveformHistoryItem::setSpanSeconds(double seconds)
+{
+    if (seconds <= 0.0 || qFuzzyCompare(m_spanSeconds, seconds))
+        return;
+    m_spanSeconds = seconds;
+    update();
+    emit spanSecondsChanged();
+}
+
+void WaveformHistoryItem::setOffsetSeconds(double seconds)
+{
+    seconds = qMax(0.0, seconds);
+    if (qFuzzyCompare(m_offsetSeconds + 1.0, seconds + 1.0))
+        return;
+    m_offsetSeconds = seconds;
+    update();
+    emit offsetSecondsChanged();
+}
+
+void WaveformHistoryItem::setLineColor(const QColor &color)
+{
+    if (m_lineColor == color)
+        return;
+    m_lineColor = color;
+    m_materialDirty = true;
+    update();
+    emit lineColorChanged();
+}
+
+void WaveformHistoryItem::setGridColor(const QColor &color)
+{
+    if (m_gridColor == color)
+        return;
+    m_gridColor = color;
+    m_materialDirty = true;
+    update();
+    emit gridColorChanged();
+}
+
+void WaveformHistoryItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_geometryDirty = true;
+        update();
+    }
+}
+
+QSGNode *WaveformHistoryItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+
+    auto *node = static_cast<HistoryNode *>(oldNode);
+
+    if (!m_history || width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new HistoryNode();
+        m_geometryDirty = true;
+        m_materialDirty = true;
+    }
+
+    if (m_materialDirty) {
+        static_cast<QSGFlatColorMaterial *>(node->grid->material())->setColor(m_gridColor);
+        static_cast<QSGFlatColorMaterial *>(node->trace->material())->setColor(m_lineColor);
+        node->grid->geometry()->setLineWidth(1.0f);
+        node->trace->geometry()->setLineWidth(1.0f);
+        node->grid->markDirty(QSGNode::DirtyMaterial);
+        node->trace->markDirty(QSGNode::DirtyMaterial);
+        m_materialDirty = false;
+    }
+
+    if (m_geometryDirty) {
+        buildGridGeometry(node->grid->geometry(), size(), GRID_ROWS, GRID_COLUMNS);
+        node->grid->markDirty(QSGNode::DirtyGeometry);
+        m_geometryDirty = false;
+    }
+
+    // Pencere her karede piramitten yeniden örneklenir: O(sütun), aralık uzunluğundan bağımsız
+    m_trace.build(node->trace->geometry(), m_history->pyramid(), m_spanSeconds, m_offsetSeconds, size());
+    node->trace->markDirty(QSGNode::DirtyGeometry);
+
+    return node;
+}
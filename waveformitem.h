@@ -0,0 +1,167 @@
+#ifndef WAVEFORMITEM_H
+#define WAVEFORMITEM_H
+
+#include <QQuickItem>
+#include <QPointer>
+#include <QColor>
+#include <QSGGeometry>
+#include "waveformhistory.h"
+#include "waveformmodel.h"
+
+// Süpürmeli (sweep) iz geometrisi: sabit sayıda segment yuvası, her yeni örnek
+// yalnızca kendi yuvasındaki iki köşeyi ve önündeki silme boşluğunu günceller.
+// Scene graph'tan bağımsızdır; benchmark'tan doğrudan çağrılabilir.
+class SweepTraceBuilder
+{
+public:
+    void reset(QSGGeometry *geometry, int slots, const QSizeF &size, int gapSlots);
+    void append(QSGGeometry *geometry, const float *values, int count);
+
+    int slots() const { return m_slots; }
+    int cursorSlot() const { return m_slot; }
+
+private:
+    float yFor(float value) const;
+    void collapse(QSGGeometry::Point2D *vertices, int slot) const;
+
+    int m_slots = 0;
+    int m_gapSlots = 0;
+    int m_slot = 0;       // bir sonraki örneğin yazılacağı yuva
+    float m_stepX = 0.0f;
+    float m_height = 0.0f;
+    float m_lastY = 0.0f;
+    bool m_hasLast = false;
+};
+
+// Zarf (envelope) iz geometrisi: piksel sütunu başına bir dikey min-max segmenti.
+// Sütunlar arası boşluk komşu sütunun aralığına uzatılarak kapatılır. Maliyet
+// yalnızca sütun sayısına bağlıdır; bin tamponu yeniden kullanılır.
+class EnvelopeTraceBuilder
+{
+public:
+    // Şimdiden endSecondsAgo önce biten spanSeconds'lık pencereyi size'a çizer
+    void build(QSGGeometry *geometry, const WaveformPyramid<quint8> &pyramid,
+               double spanSeconds, double endSecondsAgo, const QSizeF &size);
+
+private:
+    QVector<EnvelopeBin<quint8>> m_bins;
+};
+
+// QML Canvas yerine scene graph ile çizilen waveform izi.
+// Izgara ayrı, yalnızca boyut değişince yeniden kurulan statik bir düğümdür;
+// iz düğümünde her karede yalnızca yeni örneklerin segmentleri yazılır.
+class WaveformItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(WaveformModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY gridColorChanged)
+    Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+
+public:
+    explicit WaveformItem(QQuickItem *parent = nullptr);
+
+    WaveformModel *model() const { return m_model; }
+    void setModel(WaveformModel *model);
+
+    QColor lineColor() const { return m_lineColor; }
+    void setLineColor(const QColor &color);
+
+    QColor gridColor() const { return m_gridColor; }
+    void setGridColor(const QColor &color);
+
+    QColor backgroundColor() const { return m_backgroundColor; }
+    void setBackgroundColor(const QColor &color);
+
+    qreal lineWidth() const { return m_lineWidth; }
+    void setLineWidth(qreal width);
+
+signals:
+    void modelChanged();
+    void lineColorChanged();
+    void gridColorChanged();
+    void backgroundColorChanged();
+    void lineWidthChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    static const int GRID_ROWS = 8;
+    static const int GRID_COLUMNS = 10;
+    static const int SWEEP_GAP_SLOTS = 6; // imlecin önünde silinen segment sayısı
+
+    void buildGrid(QSGGeometry *geometry) const;
+
+    QPointer<WaveformModel> m_model;
+    QColor m_lineColor = QColor("#006400");
+    QColor m_gridColor = QColor("#D3D3D3");
+    QColor m_backgroundColor = QColor("#F5F5DC");
+    qreal m_lineWidth = 2.0;
+
+    SweepTraceBuilder m_trace;
+    qint64 m_cursor = 0;          // izde çizilmiş son örneğin model imleci
+    bool m_geometryDirty = true;  // boyut/model değişti: ızgara ve iz yeniden kurulur
+    bool m_materialDirty = true;
+};
+
+// Yakınlaştırılabilir geçmiş görünümü (WaveformHistoryTrace): son spanSeconds
+// saniye (offsetSeconds kadar geriden) min/max zarfı olarak çizilir. 10 saniye ile
+// 24 saat arası her pencerenin çizim maliyeti yaklaşık aynıdır.
+class WaveformHistoryItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(WaveformHistory *history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(double spanSeconds READ spanSeconds WRITE setSpanSeconds NOTIFY spanSecondsChanged)
+    Q_PROPERTY(double offsetSeconds READ offsetSeconds WRITE setOffsetSeconds NOTIFY offsetSecondsChanged)
+    Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY gridColorChanged)
+
+public:
+    explicit WaveformHistoryItem(QQuickItem *parent = nullptr);
+
+    WaveformHistory *history() const { return m_history; }
+    void setHistory(WaveformHistory *history);
+
+    double spanSeconds() const { return m_spanSeconds; }
+    void setSpanSeconds(double seconds);
+
+    // 0: canlı (sağ kenar şimdi)
+    double offsetSeconds() const { return m_offsetSeconds; }
+    void setOffsetSeconds(double seconds);
+
+    QColor lineColor() const { return m_lineColor; }
+    void setLineColor(const QColor &color);
+
+    QColor gridColor() const { return m_gridColor; }
+    void setGridColor(const QColor &color);
+
+signals:
+    void historyChanged();
+    void spanSecondsChanged();
+    void offsetSecondsChanged();
+    void lineColorChanged();
+    void gridColorChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    static const int GRID_ROWS = 4;
+    static const int GRID_COLUMNS = 10;
+
+    QPointer<WaveformHistory> m_history;
+    double m_spanSeconds = 60.0;
+    double m_offsetSeconds = 0.0;
+    QColor m_lineColor = QColor("#006400");
+    QColor m_gridColor = QColor("#D3D3D3");
+
+    EnvelopeTraceBuilder m_trace;
+    bool m_geometryDirty = true;
+    bool m_materialDirty = true;
+};
+
+#endif // WAVEFORMITEM_H
@@ -0,0 +1,78 @@
+#include "waveformmodel.h"
+
+WaveformModel::WaveformModel(int capacity, double sampleRate, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_samples(sampleRate)
+{
+    m_samples.setCapacity(capacity);
+}
+
+int WaveformModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return m_samples.size();
+}
+
+QVariant WaveformModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_samples.size())
+        return QVariant();
+
+    switch (role) {
+    case ValueRole: return valueAt(index.row());
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> WaveformModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(ValueRole, "value");
+    return roles;
+}
+
+float WaveformModel::valueAt(int row) const
+{
+    const SampleSpan<float> span = m_samples.last();
+    if (row < 0 || row >= span.size)
+        return 0.0f;
+    return span[row];
+}
+
+void WaveformModel::appendSamples(const SampleSpan<quint8> &samples)
+{
+    if (samples.isEmpty())
+        return;
+
+    // Kapasiteden fazlası zaten görünmeyecek; yalnızca en yeni kısım eklenir
+    const int incoming = qMin(samples.size, m_samples.capacity());
+    const quint8 *data = samples.data + (samples.size - incoming);
+
+    const int current = m_samples.size();
+    const int evicted = qMax(0, current + incoming - m_samples.capacity());
+
+    if (evicted > 0) {
+        beginRemoveRows(QModelIndex(), 0, evicted - 1);
+        m_samples.dropOldest(evicted);
+        endRemoveRows();
+    }
+
+    const int first = current - evicted;
+    beginInsertRows(QModelIndex(), first, first + incoming - 1);
+    for (int i = 0; i < incoming; ++i)
+        m_samples.append(static_cast<float>(data[i]), samples.lastTimestamp);
+    endInsertRows();
+
+    emit samplesAppended(m_samples.totalWritten(), incoming);
+}
+
+void WaveformModel::clear()
+{
+    if (m_samples.isEmpty())
+        return;
+
+    beginResetModel();
+    m_samples.clear();
+    endResetModel();
+    emit samplesAppended(m_samples.totalWritten(), 0);
+}
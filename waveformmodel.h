@@ -0,0 +1,52 @@
+#ifndef WAVEFORMMODEL_H
+#define WAVEFORMMODEL_H
+
+#include <QAbstractListModel>
+#include "samplering.h"
+
+// Ekranda gösterilen son N waveform örneğinin artımlı, tipli modeli.
+// Yeni örnekler satır ekleme, taşanlar satır silme sinyalleriyle bildirilir;
+// her örnek O(1) maliyetlidir ve QVariantList yeniden oluşturulmaz.
+// C++ çiziciler writeCursor()/since() ile yalnızca yeni örnekleri okuyabilir.
+class WaveformModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY samplesAppended)
+    Q_PROPERTY(int capacity READ capacity CONSTANT)
+    Q_PROPERTY(qint64 writeCursor READ writeCursor NOTIFY samplesAppended)
+
+public:
+    enum Roles {
+        ValueRole = Qt::UserRole + 1
+    };
+
+    explicit WaveformModel(int capacity, double sampleRate, QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_samples.size(); }
+    int capacity() const { return m_samples.capacity(); }
+    qint64 writeCursor() const { return m_samples.totalWritten(); }
+
+    // row 0 en eski örnek
+    Q_INVOKABLE float valueAt(int row) const;
+
+    // cursor sonrasında eklenen örneklerin bitişik görünümü (C++ çiziciler için)
+    SampleSpan<float> since(qint64 cursor) const { return m_samples.since(cursor); }
+    SampleSpan<float> values() const { return m_samples.last(); }
+
+    void appendSamples(const SampleSpan<quint8> &samples);
+    void clear();
+
+signals:
+    // count: bu partide eklenen örnek sayısı, cursor: yeni writeCursor
+    void samplesAppended(qint64 cursor, int count);
+
+private:
+    SampleRing<float> m_samples;
+};
+
+#endif // WAVEFORMMODEL_H
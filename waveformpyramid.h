@@ -0,0 +1,229 @@
+#ifndef WAVEFORMPYRAMID_H
+#define WAVEFORMPYRAMID_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <cmath>
+
+// Ekran sütunu başına çizilecek aralık; valid == false ise sütunda veri yok
+template <typename T>
+struct EnvelopeBin {
+    T minimum = T();
+    T maximum = T();
+    bool valid = false;
+};
+
+// Örnek geçmişi üzerinde artımlı min/max piramidi.
+// Seviye k, FANOUT^k örneklik blokların min/max çiftlerini sabit kapasiteli bir
+// halkada tutar (seviye 0 ham örneklerdir). Her append amortize O(1)'dir: bir blok
+// tamamlandığında yalnızca bir üst seviyenin birikimcisi güncellenir.
+// envelope() her sütun için blok boyu sütun genişliğini aşmayan en kaba seviyeyi
+// seçer ve sütun başına en fazla FANOUT + 1 blok okur; maliyet aralığın uzunluğundan
+// bağımsız, yalnızca sütun sayısıyla orantılıdır. Sütun sınırları blok ızgarasına
+// hizalanır; böylece yeni örnekler geldikçe eski sütunlar titremez.
+template <typename T>
+class WaveformPyramid
+{
+public:
+    static const int FANOUT = 4;
+    static const int TOP_LEVEL_BINS = 256; // en kaba seviyede geçmişi kaplayan yaklaşık blok sayısı
+
+    explicit WaveformPyramid(double sampleRate = 50.0, double historySeconds = 3600.0)
+        : m_sampleRate(sampleRate)
+    {
+        setHistorySeconds(historySeconds);
+    }
+
+    double sampleRate() const { return m_sampleRate; }
+    double historySeconds() const { return m_historySeconds; }
+    int levelCount() const { return m_levels.size(); }
+    qint64 blockSize(int level) const { return m_levels.at(level).block; }
+    qint64 totalWritten() const { return m_written; }
+    qint64 lastTimestamp() const { return m_lastTimestamp; }
+
+    // Saklanan en eski ham örneğin indeksi
+    qint64 oldestIndex() const { return qMax<qint64>(0, m_written - m_levels.at(0).capacity); }
+    double availableSeconds() const { return (m_written - oldestIndex()) / m_sampleRate; }
+
+    // Geçmiş süresini değiştirir; seviyeler yeniden kurulur ve içerik atılır
+    void setHistorySeconds(double seconds)
+    {
+        m_historySeconds = qMax(1.0, seconds);
+        rebuild();
+    }
+
+    // Örnekleme hızı değişince eski bloklar farklı zaman ölçeğindedir; içerik atılır
+    void setSampleRate(double sampleRate)
+    {
+        if (sampleRate <= 0.0 || sampleRate == m_sampleRate)
+            return;
+        m_sampleRate = sampleRate;
+        rebuild();
+    }
+
+    void clear()
+    {
+        m_written = 0;
+        m_lastTimestamp = 0;
+        for (Level &level : m_levels) {
+            level.completed = 0;
+            level.pendingCount = 0;
+        }
+    }
+
+    void append(T value, qint64 timestamp)
+    {
+        Level *levels = m_levels.data();
+        levels[0].minimum[static_cast<int>(m_written % levels[0].capacity)] = value;
+        ++levels[0].completed;
+        ++m_written;
+        m_lastTimestamp = timestamp;
+
+        // Tamamlanan blok bir üst seviyenin birikimcisine eklenir
+        T lo = value;
+        T hi = value;
+        for (int k = 1; k < m_levels.size(); ++k) {
+            Level &level = levels[k];
+            if (level.pendingCount == 0) {
+                level.pendingMin = lo;
+                level.pendingMax = hi;
+            } else {
+                if (lo < level.pendingMin) level.pendingMin = lo;
+                if (hi > level.pendingMax) level.pendingMax = hi;
+            }
+            if (++level.pendingCount < FANOUT)
+                break;
+
+            const int slot = static_cast<int>(level.completed % level.capacity);
+            level.minimum[slot] = level.pendingMin;
+            level.maximum[slot] = level.pendingMax;
+            ++level.completed;
+            level.pendingCount = 0;
+            lo = level.pendingMin;
+            hi = level.pendingMax;
+        }
+    }
+
+    // [first, end) ham örnek aralığını columns sütuna indirger. Aralığın geçmişte
+    // olmayan kısmına düşen sütunlar valid == false döner. Veri içeren sütun sayısını döndürür.
+    int envelope(qint64 first, qint64 end, int columns, EnvelopeBin<T> *out) const
+    {
+        if (columns <= 0)
+            return 0;
+        if (end <= first) {
+            for (int c = 0; c < columns; ++c)
+                out[c] = EnvelopeBin<T>();
+            return 0;
+        }
+
+        const double perColumn = static_cast<double>(end - first) / columns;
+        int levelIndex = 0;
+        while (levelIndex + 1 < m_levels.size() && m_levels.at(levelIndex + 1).block <= perColumn)
+            ++levelIndex;
+        const Level &level = m_levels.at(levelIndex);
+
+        int filled = 0;
+        for (int c = 0; c < columns; ++c) {
+            const qint64 a = first + static_cast<qint64>(c * perColumn);
+            const qint64 b = qMax(a + 1, first + static_cast<qint64>((c + 1) * perColumn));
+
+            EnvelopeBin<T> bin;
+            const qint64 lastBlock = floorDiv(b - 1, level.block);
+            for (qint64 j = floorDiv(a, level.block); j <= lastBlock; ++j)
+                merge(bin, blockAt(levelIndex, j));
+            out[c] = bin;
+            if (bin.valid)
+                ++filled;
+        }
+        return filled;
+    }
+
+    // Şimdiden endSecondsAgo saniye öncesinde biten spanSeconds uzunluğundaki pencere
+    int envelopeSeconds(double spanSeconds, double endSecondsAgo, int columns, EnvelopeBin<T> *out) const
+    {
+        const qint64 end = m_written - static_cast<qint64>(std::llround(qMax(0.0, endSecondsAgo) * m_sampleRate));
+        const qint64 first = end - qMax<qint64>(1, std::llround(spanSeconds * m_sampleRate));
+        return envelope(first, end, columns, out);
+    }
+
+private:
+    struct Level {
+        qint64 block = 1;     // blok başına ham örnek
+        int capacity = 0;     // halkadaki blok sayısı
+        QVector<T> minimum;   // seviye 0'da ham örnekler
+        QVector<T> maximum;   // seviye 0'da boş (minimum ile aynı)
+        qint64 completed = 0; // tamamlanmış blok sayısı (monoton)
+        T pendingMin = T();   // tamamlanmamış bloğun birikimcisi (yalnızca alt seviyenin tamamlanmış blokları)
+        T pendingMax = T();
+        int pendingCount = 0;
+    };
+
+    static qint64 floorDiv(qint64 a, qint64 b)
+    {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+
+    static void merge(EnvelopeBin<T> &bin, const EnvelopeBin<T> &other)
+    {
+        if (!other.valid)
+            return;
+        if (!bin.valid) {
+            bin = other;
+            return;
+        }
+        if (other.minimum < bin.minimum) bin.minimum = other.minimum;
+        if (other.maximum > bin.maximum) bin.maximum = other.maximum;
+    }
+
+    EnvelopeBin<T> blockAt(int levelIndex, qint64 j) const
+    {
+        const Level &level = m_levels.at(levelIndex);
+        EnvelopeBin<T> bin;
+        if (j < 0 || j < level.completed - level.capacity || j > level.completed)
+            return bin;
+
+        if (j < level.completed) {
+            const int slot = static_cast<int>(j % level.capacity);
+            bin.minimum = level.minimum.at(slot);
+            bin.maximum = levelIndex == 0 ? bin.minimum : level.maximum.at(slot);
+            bin.valid = true;
+            return bin;
+        }
+
+        // En yeni, yarım blok: birikimciler alt seviyelerden aşağı doğru birleştirilir
+        for (int k = levelIndex; k >= 1; --k) {
+            const Level &partial = m_levels.at(k);
+            if (partial.pendingCount > 0)
+                merge(bin, {partial.pendingMin, partial.pendingMax, true});
+        }
+        return bin;
+    }
+
+    void rebuild()
+    {
+        const qint64 samples = qMax<qint64>(1, static_cast<qint64>(std::ceil(m_historySeconds * m_sampleRate)));
+
+        m_levels.clear();
+        qint64 block = 1;
+        do {
+            Level level;
+            level.block = block;
+            level.capacity = static_cast<int>((samples + block - 1) / block) + 1;
+            level.minimum.resize(level.capacity);
+            if (block > 1)
+                level.maximum.resize(level.capacity);
+            m_levels.append(level);
+            block *= FANOUT;
+        } while (samples / (block / FANOUT) > TOP_LEVEL_BINS);
+
+        clear();
+    }
+
+    QVector<Level> m_levels;
+    qint64 m_written = 0;
+    qint64 m_lastTimestamp = 0;
+    double m_sampleRate;
+    double m_historySeconds = 0.0;
+};
+
+#endif // WAVEFORMPYRAMID_H
@@ -0,0 +1,125 @@
+#include "waveformstatistics.h"
+#include <QDebug>
+#include <cmath>
+
+// --- StreamingStats ---
+
+void StreamingStats::configure(int windowSamples)
+{
+    m_window = qMax(1, windowSamples);
+    m_history.resize(m_window);
+    m_max.configure(m_window);
+    m_min.configure(m_window);
+    reset();
+}
+
+void StreamingStats::reset()
+{
+    m_index = 0;
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_max.reset();
+    m_min.reset();
+}
+
+void StreamingStats::add(float value)
+{
+    const int slot = static_cast<int>(m_index % m_window);
+
+    if (m_count == m_window) {
+        // Pencereden çıkan örneği Welford toplamından geri al
+        if (m_count == 1) {
+            m_mean = 0.0;
+            m_m2 = 0.0;
+        } else {
+            const double old = m_history[slot];
+            const double delta = old - m_mean;
+            m_mean -= delta / (m_count - 1);
+            m_m2 -= delta * (old - m_mean);
+        }
+        --m_count;
+    }
+
+    m_history[slot] = value;
+    ++m_count;
+    const double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+    if (m_m2 < 0.0)
+        m_m2 = 0.0; // yuvarlama hatası
+
+    m_max.push(m_index, value);
+    m_min.push(m_index, value);
+    ++m_index;
+}
+
+double StreamingStats::standardDeviation() const
+{
+    return std::sqrt(variance());
+}
+
+// --- WaveformStatistics ---
+
+WaveformStatistics::WaveformStatistics(double sampleRate, double windowSeconds, QObject *parent)
+    : QObject(parent)
+    , m_sampleRate(sampleRate)
+    , m_windowSeconds(windowSeconds)
+{
+    reconfigure();
+}
+
+void WaveformStatistics::setWindowSeconds(double seconds)
+{
+    if (seconds <= 0.0 || qFuzzyCompare(seconds, m_windowSeconds))
+        return;
+
+    m_windowSeconds = seconds;
+    reconfigure();
+    qDebug() << "WaveformStatistics: pencere" << seconds << "saniye (" << m_stats.windowSamples() << "örnek)";
+    emit windowSecondsChanged();
+}
+
+void WaveformStatistics::setSampleRate(double sampleRate)
+{
+    if (sampleRate <= 0.0 || qFuzzyCompare(sampleRate, m_sampleRate))
+        return;
+
+    m_sampleRate = sampleRate;
+    reconfigure();
+}
+
+void WaveformStatistics::reset()
+{
+    m_stats.reset();
+    publish();
+}
+
+void WaveformStatistics::reconfigure()
+{
+    // Pencere boyutu değişince geçmiş geçersizdir; yeni pencere sıfırdan dolar
+    m_stats.configure(qMax(1, static_cast<int>(std::lround(m_windowSeconds * m_sampleRate))));
+    publish();
+}
+
+void WaveformStatistics::publish()
+{
+    Snapshot next;
+    next.count = m_stats.count();
+    if (next.count > 0) {
+        next.minimum = m_stats.minimum();
+        next.maximum = m_stats.maximum();
+        next.mean = m_stats.mean();
+        next.standardDeviation = m_stats.standardDeviation();
+        next.perfusionIndex = m_stats.perfusionIndex();
+    }
+
+    if (next.count == m_published.count && next.minimum == m_published.minimum
+        && next.maximum == m_published.maximum && next.mean == m_published.mean
+        && next.standardDeviation == m_published.standardDeviation) {
+        return;
+    }
+
+    m_published = next;
+    emit updated();
+}
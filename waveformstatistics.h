@@ -0,0 +1,147 @@
+#ifndef WAVEFORMSTATISTICS_H
+#define WAVEFORMSTATISTICS_H
+
+#include <QObject>
+#include <QVector>
+
+// Kayan pencerede min/max için monoton deque; sabit kapasiteli halka üzerinde.
+// Her push amortize O(1)'dir, configure dışında bellek ayırmaz.
+template <typename Dominates>
+class MonotonicWindow
+{
+public:
+    void configure(int window)
+    {
+        m_window = qMax(1, window);
+        m_entries.resize(m_window);
+        reset();
+    }
+    void reset() { m_head = 0; m_size = 0; }
+
+    void push(qint64 index, float value)
+    {
+        // Pencereden çıkan en eski girdi (yeni girdiye yer açılır: boyut <= pencere)
+        if (m_size > 0 && front().index <= index - m_window) {
+            m_head = (m_head + 1) % m_window;
+            --m_size;
+        }
+        // Yeni değerin baskıladığı girdiler bir daha uç değer olamaz
+        while (m_size > 0 && !Dominates()(back().value, value))
+            --m_size;
+        m_entries[(m_head + m_size) % m_window] = {index, value};
+        ++m_size;
+    }
+
+    bool isEmpty() const { return m_size == 0; }
+    float value() const { return front().value; }
+
+private:
+    struct Entry {
+        qint64 index;
+        float value;
+    };
+    const Entry &front() const { return m_entries[m_head]; }
+    const Entry &back() const { return m_entries[(m_head + m_size - 1) % m_window]; }
+
+    QVector<Entry> m_entries;
+    int m_window = 1;
+    int m_head = 0;
+    int m_size = 0;
+};
+
+struct GreaterThan { bool operator()(float a, float b) const { return a > b; } };
+struct LessThan { bool operator()(float a, float b) const { return a < b; } };
+
+// Kayan pencere istatistikleri: min/max (monoton deque), ortalama/varyans
+// (pencereden çıkan örneği geri alan Welford), tepe-tepe genlik ve perfüzyon
+// indeksi tahmini. Örnek başına O(1), configure dışında bellek ayırmaz.
+class StreamingStats
+{
+public:
+    void configure(int windowSamples);
+    void reset();
+    void add(float value);
+
+    int windowSamples() const { return m_window; }
+    int count() const { return m_count; }
+    float minimum() const { return m_min.isEmpty() ? 0.0f : m_min.value(); }
+    float maximum() const { return m_max.isEmpty() ? 0.0f : m_max.value(); }
+    float peakToPeak() const { return maximum() - minimum(); }
+    double mean() const { return m_mean; }
+    double variance() const { return m_count > 1 ? m_m2 / (m_count - 1) : 0.0; }
+    double standardDeviation() const;
+    // AC/DC oranı (%): tepe-tepe / ortalama. Ham pleth ölçeğinde bir tahmindir;
+    // DC giderme açıkken anlamsızdır (ortalama ekran ofsetidir)
+    double perfusionIndex() const { return m_mean > 0.0 ? 100.0 * peakToPeak() / m_mean : 0.0; }
+
+private:
+    int m_window = 1;
+    QVector<float> m_history; // Welford'dan geri almak için pencere halkası
+    qint64 m_index = 0;
+    int m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;
+    MonotonicWindow<GreaterThan> m_max;
+    MonotonicWindow<LessThan> m_min;
+};
+
+// Reader örnek akışına bağlı istatistikler; QML'e kare başına en fazla bir kez
+// (NotificationScheduler::StatsChannel) bildirilir. Değerler m_waveformBuffer
+// taranarak değil, her örnekte artımlı olarak güncellenir.
+class WaveformStatistics : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double windowSeconds READ windowSeconds WRITE setWindowSeconds NOTIFY windowSecondsChanged)
+    Q_PROPERTY(int sampleCount READ sampleCount NOTIFY updated)
+    Q_PROPERTY(double minimum READ minimum NOTIFY updated)
+    Q_PROPERTY(double maximum READ maximum NOTIFY updated)
+    Q_PROPERTY(double peakToPeak READ peakToPeak NOTIFY updated)
+    Q_PROPERTY(double mean READ mean NOTIFY updated)
+    Q_PROPERTY(double standardDeviation READ standardDeviation NOTIFY updated)
+    Q_PROPERTY(double perfusionIndex READ perfusionIndex NOTIFY updated)
+
+public:
+    explicit WaveformStatistics(double sampleRate, double windowSeconds = 5.0, QObject *parent = nullptr);
+
+    double windowSeconds() const { return m_windowSeconds; }
+    void setWindowSeconds(double seconds);
+    void setSampleRate(double sampleRate);
+
+    int sampleCount() const { return m_published.count; }
+    double minimum() const { return m_published.minimum; }
+    double maximum() const { return m_published.maximum; }
+    double peakToPeak() const { return m_published.maximum - m_published.minimum; }
+    double mean() const { return m_published.mean; }
+    double standardDeviation() const { return m_published.standardDeviation; }
+    double perfusionIndex() const { return m_published.perfusionIndex; }
+
+    // GUI thread'inde, kuyruk boşaltılırken örnek başına çağrılır (O(1))
+    void addSample(float value) { m_stats.add(value); }
+    void reset();
+
+    // Birikmiş güncellemeleri özellik değerlerine aktarır; değiştiyse updated() yayınlar
+    void publish();
+
+signals:
+    void updated();
+    void windowSecondsChanged();
+
+private:
+    void reconfigure();
+
+    struct Snapshot {
+        int count = 0;
+        double minimum = 0.0;
+        double maximum = 0.0;
+        double mean = 0.0;
+        double standardDeviation = 0.0;
+        double perfusionIndex = 0.0;
+    };
+
+    StreamingStats m_stats;
+    Snapshot m_published;
+    double m_sampleRate;
+    double m_windowSeconds;
+};
+
+#endif // WAVEFORMSTATISTICS_H
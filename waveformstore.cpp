@@ -0,0 +1,363 @@
+#include "waveformstore.h"
+#include "waveformcodec.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+QString segmentPath(const QString &directory, int index)
+{
+    return QDir(directory).filePath(QStringLiteral("segment_%1.wseg").arg(index, 6, 10, QLatin1Char('0')));
+}
+
+// Sıkıştırılmış parça yükünü out'a çözer; başarısızsa false
+bool decodePayload(const WaveformChunkInfo &info, const uchar *payload, QByteArray &out)
+{
+    switch (info.encoding) {
+    case WaveformChunk::DeltaPack:
+        out.resize(static_cast<qsizetype>(info.sampleCount));
+        return WaveformCodec::decode(payload, static_cast<int>(info.payloadSize),
+                                     reinterpret_cast<quint8 *>(out.data()), out.size());
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+WaveformStore::WaveformStore(const QString &directory, qint64 segmentSize, QObject *parent)
+    : QObject(parent)
+    , m_directory(directory)
+    , m_segmentSize(qMax<qint64>(segmentSize, 64 * 1024))
+{
+}
+
+WaveformStore::~WaveformStore()
+{
+    closeAll();
+    qDeleteAll(m_patients);
+}
+
+void WaveformStore::closeAll()
+{
+    QMutexLocker locker(&m_mutex);
+    for (Patient *p : std::as_const(m_patients)) {
+        if (p->file.isOpen())
+            p->file.close();
+    }
+}
+
+WaveformStore::Patient *WaveformStore::patient(int patientId, bool create) const
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (Patient *p = m_patients.value(patientId))
+            return p;
+    }
+
+    const QString directory = QDir(m_directory).filePath(QStringLiteral("patient_%1").arg(patientId));
+    if (!create && !QFileInfo::exists(directory))
+        return nullptr;
+
+    // Mevcut segmentlerin yalnızca parça başlıkları okunur; kilit dışında, uzun bir arşivin
+    // ilk okuması depolama thread'inin yazımını bekletmez
+    auto *loaded = new Patient;
+    loaded->directory = directory;
+    const QStringList names = QDir(directory).entryList({"segment_*.wseg"}, QDir::Files, QDir::Name);
+    for (const QString &name : names) {
+        loaded->segments.append(QDir(directory).filePath(name));
+        scanSegment(loaded, loaded->segments.size() - 1);
+    }
+    std::sort(loaded->chunks.begin(), loaded->chunks.end(),
+              [](const WaveformChunkInfo &a, const WaveformChunkInfo &b) { return a.startMs < b.startMs; });
+
+    {
+        QMutexLocker locker(&m_mutex);
+        // Aynı hastayı başka bir thread de taradıysa ilk eklenen kullanılır
+        if (Patient *p = m_patients.value(patientId)) {
+            delete loaded;
+            return p;
+        }
+        m_patients.insert(patientId, loaded);
+    }
+    if (!loaded->chunks.isEmpty())
+        qDebug() << "WaveformStore: hasta" << patientId << "için" << loaded->chunks.size() << "parça,"
+                 << loaded->segments.size() << "segment";
+    return loaded;
+}
+
+void WaveformStore::scanSegment(Patient *p, int segment)
+{
+    QFile file(p->segments.at(segment));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const qint64 size = file.size();
+    if (size < static_cast<qint64>(sizeof(WaveformChunk::SegmentHeader)))
+        return;
+    const uchar *base = file.map(0, size);
+    if (!base)
+        return;
+
+    WaveformChunk::SegmentHeader segmentHeader;
+    std::memcpy(&segmentHeader, base, sizeof(segmentHeader));
+    if (std::memcmp(segmentHeader.magic, WaveformChunk::SegmentMagic, sizeof(segmentHeader.magic)) != 0) {
+        qWarning() << "WaveformStore: geçersiz segment başlığı:" << file.fileName();
+        file.unmap(const_cast<uchar *>(base));
+        return;
+    }
+
+    qint64 offset = segmentHeader.headerSize;
+    while (offset + static_cast<qint64>(sizeof(WaveformChunk::Header)) <= size) {
+        WaveformChunk::Header header;
+        std::memcpy(&header, base + offset, sizeof(header));
+        const qint64 end = offset + static_cast<qint64>(sizeof(header)) + header.payloadSize;
+        if (std::memcmp(header.magic, WaveformChunk::ChunkMagic, sizeof(header.magic)) != 0
+            || end > size || header.sampleRate <= 0.0f) {
+            qWarning() << "WaveformStore: segment sonunda yarım parça yok sayıldı:" << file.fileName() << offset;
+            break;
+        }
+
+        WaveformChunkInfo info;
+        info.startMs = header.startMs;
+        info.sampleCount = header.sampleCount;
+        info.sampleRate = header.sampleRate;
+        info.endMs = header.startMs + static_cast<qint64>(std::llround(header.sampleCount * 1000.0 / header.sampleRate));
+        info.encoding = header.encoding;
+        info.payloadSize = header.payloadSize;
+        info.segment = segment;
+        info.offset = offset;
+        p->chunks.append(info);
+        p->maxDurationMs = qMax(p->maxDurationMs, info.endMs - info.startMs);
+        offset = end;
+    }
+
+    file.unmap(const_cast<uchar *>(base));
+}
+
+bool WaveformStore::openNextSegment(Patient *p, int patientId)
+{
+    if (p->file.isOpen())
+        p->file.close();
+
+    if (!QDir().mkpath(p->directory)) {
+        qWarning() << "WaveformStore: dizin oluşturulamadı:" << p->directory;
+        return false;
+    }
+
+    // Yeni segmentin sırası: mevcut en son dosyadan sonra (yarım kalmış segmente eklenmez)
+    int index = 0;
+    if (!p->segments.isEmpty()) {
+        const QString last = QFileInfo(p->segments.last()).completeBaseName();
+        index = last.mid(QStringLiteral("segment_").size()).toInt() + 1;
+    }
+
+    const QString path = segmentPath(p->directory, index);
+    p->file.setFileName(path);
+    if (!p->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "WaveformStore: segment açılamadı:" << path << p->file.errorString();
+        return false;
+    }
+
+    WaveformChunk::SegmentHeader header;
+    std::memcpy(header.magic, WaveformChunk::SegmentMagic, sizeof(header.magic));
+    header.patientId = patientId;
+    header.segmentIndex = static_cast<quint32>(index);
+    header.createdAtMs = QDateTime::currentMSecsSinceEpoch();
+    header.headerSize = sizeof(WaveformChunk::SegmentHeader);
+    header.reserved = 0;
+    if (p->file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header)) {
+        qWarning() << "WaveformStore: segment başlığı yazılamadı:" << p->file.errorString();
+        p->file.close();
+        return false;
+    }
+    p->fileSize = sizeof(header);
+
+    QMutexLocker locker(&m_mutex);
+    p->segments.append(path);
+    return true;
+}
+
+void WaveformStore::appendChunk(int patientId, qint64 startMs, double sampleRate, const QByteArray &samples)
+{
+    if (patientId <= 0 || samples.isEmpty() || sampleRate <= 0.0)
+        return;
+
+    Patient *p = patient(patientId, true);
+
+    // Kodlama depolama thread'inde; delta kodlama zlib'e yakın oran verir, çözmesi çok daha hızlıdır
+    QByteArray payload = WaveformCodec::encode(reinterpret_cast<const quint8 *>(samples.constData()),
+                                               static_cast<int>(samples.size()));
+    quint8 encoding = WaveformChunk::DeltaPack;
+    if (payload.size() >= samples.size()) {
+        payload = samples;
+        encoding = WaveformChunk::Raw;
+    }
+
+    const qint64 recordSize = static_cast<qint64>(sizeof(WaveformChunk::Header)) + payload.size();
+    if (!p->file.isOpen() || p->fileSize + recordSize > m_segmentSize) {
+        if (!openNextSegment(p, patientId))
+            return;
+    }
+
+    WaveformChunk::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, WaveformChunk::ChunkMagic, sizeof(header.magic));
+    header.payloadSize = static_cast<quint32>(payload.size());
+    header.startMs = startMs;
+    header.sampleCount = static_cast<quint32>(samples.size());
+    header.sampleRate = static_cast<float>(sampleRate);
+    header.encoding = encoding;
+
+    const qint64 offset = p->fileSize;
+    if (p->file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header)
+        || p->file.write(payload) != payload.size() || !p->file.flush()) {
+        qWarning() << "WaveformStore: parça yazılamadı:" << p->file.fileName() << p->file.errorString();
+        // Yarım parçanın arkasına yazılmasın; sonraki parça yeni segmentte
+        p->file.close();
+        return;
+    }
+    p->fileSize += recordSize;
+
+    WaveformChunkInfo info;
+    info.startMs = startMs;
+    info.sampleCount = header.sampleCount;
+    info.sampleRate = header.sampleRate;
+    info.endMs = startMs + static_cast<qint64>(std::llround(samples.size() * 1000.0 / sampleRate));
+    info.encoding = encoding;
+    info.payloadSize = header.payloadSize;
+    info.offset = offset;
+
+    {
+        // Parça yalnızca dosyaya tamamen yazıldıktan sonra okuyuculara görünür olur
+        QMutexLocker locker(&m_mutex);
+        info.segment = p->segments.size() - 1;
+        if (p->chunks.isEmpty() || p->chunks.last().startMs <= startMs) {
+            p->chunks.append(info);
+        } else {
+            auto pos = std::upper_bound(p->chunks.begin(), p->chunks.end(), startMs,
+                                        [](qint64 t, const WaveformChunkInfo &c) { return t < c.startMs; });
+            p->chunks.insert(pos, info);
+        }
+        p->maxDurationMs = qMax(p->maxDurationMs, info.endMs - info.startMs);
+    }
+
+    m_chunksWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(static_cast<quint64>(recordSize), std::memory_order_relaxed);
+    m_samplesWritten.fetch_add(static_cast<quint64>(samples.size()), std::memory_order_relaxed);
+    emit chunkStored(patientId, info.startMs, info.endMs);
+}
+
+QVector<WaveformChunkInfo> WaveformStore::findChunks(int patientId, qint64 fromMs, qint64 toMs,
+                                                     QStringList *segments) const
+{
+    QVector<WaveformChunkInfo> result;
+    if (toMs < fromMs)
+        return result;
+
+    const Patient *p = patient(patientId, false);
+    if (!p)
+        return result;
+
+    QMutexLocker locker(&m_mutex);
+
+    // startMs'e göre ikili arama; en uzun parça süresi kadar geriden başlanır
+    auto it = std::lower_bound(p->chunks.cbegin(), p->chunks.cend(), fromMs - p->maxDurationMs,
+                               [](const WaveformChunkInfo &c, qint64 t) { return c.startMs < t; });
+    for (; it != p->chunks.cend() && it->startMs <= toMs; ++it) {
+        if (it->endMs > fromMs)
+            result.append(*it);
+    }
+    if (segments)
+        *segments = p->segments;
+    return result;
+}
+
+QVector<WaveformChunkInfo> WaveformStore::chunks(int patientId, qint64 fromMs, qint64 toMs) const
+{
+    return findChunks(patientId, fromMs, toMs, nullptr);
+}
+
+QVector<WaveformRange> WaveformStore::readRange(int patientId, qint64 fromMs, qint64 toMs) const
+{
+    QVector<WaveformRange> ranges;
+    QStringList segments;
+    const QVector<WaveformChunkInfo> found = findChunks(patientId, fromMs, toMs, &segments);
+    if (found.isEmpty())
+        return ranges;
+
+    QFile file;
+    const uchar *base = nullptr;
+    int mappedSegment = -1;
+    QByteArray decoded;
+
+    for (const WaveformChunkInfo &info : found) {
+        // Aynı segmentteki ardışık parçalar tek eşleme üzerinden okunur
+        if (info.segment != mappedSegment) {
+            if (base)
+                file.unmap(const_cast<uchar *>(base));
+            file.close();
+            base = nullptr;
+            mappedSegment = info.segment;
+
+            file.setFileName(segments.value(info.segment));
+            if (file.open(QIODevice::ReadOnly))
+                base = file.map(0, file.size());
+            if (!base) {
+                qWarning() << "WaveformStore: segment belleğe eşlenemedi:" << file.fileName();
+                continue;
+            }
+        }
+        if (!base || info.offset + static_cast<qint64>(sizeof(WaveformChunk::Header)) + info.payloadSize > file.size())
+            continue;
+
+        // Ham parçalar doğrudan eşlenmiş sayfalardan kopyalanır
+        const uchar *payload = base + info.offset + sizeof(WaveformChunk::Header);
+        const quint8 *source = nullptr;
+        if (info.encoding == WaveformChunk::Raw && info.payloadSize == info.sampleCount) {
+            source = payload;
+        } else if (decodePayload(info, payload, decoded)) {
+            source = reinterpret_cast<const quint8 *>(decoded.constData());
+        } else {
+            qWarning() << "WaveformStore: parça çözülemedi:" << file.fileName() << info.offset;
+            continue;
+        }
+        const int count = static_cast<int>(info.sampleCount);
+
+        // Parçanın [fromMs, toMs] içine düşen örnekleri
+        const double perSample = 1000.0 / info.sampleRate;
+        const int first = qBound(0, static_cast<int>(std::ceil((fromMs - info.startMs) / perSample)), count);
+        const int last = qBound(0, static_cast<int>(std::floor((toMs - info.startMs) / perSample)) + 1, count);
+        if (last <= first)
+            continue;
+        const qint64 startMs = info.startMs + static_cast<qint64>(first * perSample);
+
+        // Önceki aralığın devamıysa birleştir (parça başları gerçek zamandır, küçük sapma olağan)
+        if (!ranges.isEmpty()) {
+            WaveformRange &previous = ranges.last();
+            if (qFuzzyCompare(previous.sampleRate, static_cast<double>(info.sampleRate))
+                && qAbs(startMs - previous.endMs()) <= WaveformChunk::ContinuityToleranceMs) {
+                const int at = previous.samples.size();
+                previous.samples.resize(at + (last - first));
+                std::memcpy(previous.samples.data() + at, source + first, static_cast<size_t>(last - first));
+                continue;
+            }
+        }
+
+        WaveformRange range;
+        range.startMs = startMs;
+        range.sampleRate = info.sampleRate;
+        range.samples.resize(last - first);
+        std::memcpy(range.samples.data(), source + first, static_cast<size_t>(last - first));
+        ranges.append(range);
+    }
+
+    if (base)
+        file.unmap(const_cast<uchar *>(base));
+    return ranges;
+}
@@ -0,0 +1,150 @@
+#ifndef WAVEFORMSTORE_H
+#define WAVEFORMSTORE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+// Uzun süreli waveform arşivi: hasta başına değişmez, sıkıştırılmış parçalar (chunk).
+// Parçalar WaveformCodec ile kodlanır (bkz. waveformcodec.h).
+//
+//   <dizin>/patient_<id>/segment_000000.wseg, segment_000001.wseg, ...
+//
+// Segment: 32 baytlık başlık + art arda parçalar. Parça: 32 baytlık başlık
+// (başlangıç zamanı, örnek sayısı, örnekleme hızı, kodlama) + kodlanmış örnekler.
+// Zaman damgaları saklanmaz; i. örneğin zamanı startMs + i * 1000 / sampleRate.
+// Segmentler yalnızca sona eklenerek büyür; yarım yazılmış son parça (çökme)
+// açılışta yok sayılır ve yazım yeni bir segmentte devam eder.
+namespace WaveformChunk {
+
+constexpr char SegmentMagic[8] = {'B', 'L', 'W', 'A', 'V', 'v', '1', '\0'};
+constexpr char ChunkMagic[4] = {'W', 'C', 'H', 'K'};
+
+// Gerçek zaman ile örnek sayısından türetilen zaman arasında bu kadar sapma olan
+// ardışık parçalar kesintisiz sayılır (Reader bu sınırı aşınca yeni parça başlatır)
+constexpr qint64 ContinuityToleranceMs = 1000;
+
+enum Encoding : quint8 {
+    Raw = 0,      // 8 bit örnekler, olduğu gibi
+    DeltaPack = 1 // WaveformCodec (delta + zigzag + bit paketleme)
+};
+
+struct SegmentHeader {
+    char magic[8];
+    qint32 patientId;
+    quint32 segmentIndex;
+    qint64 createdAtMs;
+    quint32 headerSize;   // sizeof(SegmentHeader)
+    quint32 reserved;
+};
+static_assert(sizeof(SegmentHeader) == 32, "SegmentHeader 32 bayt olmalı");
+
+struct Header {
+    char magic[4];
+    quint32 payloadSize;
+    qint64 startMs;       // ilk örneğin zamanı (milliseconds since epoch)
+    quint32 sampleCount;
+    float sampleRate;     // Hz
+    quint8 encoding;
+    quint8 reserved[7];
+};
+static_assert(sizeof(Header) == 32, "Chunk başlığı 32 bayt olmalı");
+
+} // namespace WaveformChunk
+
+// Bir zaman aralığının kesintisiz örnekleri (parçalar arasında boşluk yoksa birleştirilir)
+struct WaveformRange {
+    qint64 startMs = 0;
+    double sampleRate = 0.0;
+    QVector<quint8> samples;
+
+    qint64 timestampAt(int i) const { return startMs + static_cast<qint64>(i * 1000.0 / sampleRate); }
+    qint64 endMs() const { return timestampAt(samples.size()); }
+};
+
+// Parça dizini girdisi (yalnızca bellekte; açılışta segment başlıklarından kurulur)
+struct WaveformChunkInfo {
+    qint64 startMs = 0;
+    qint64 endMs = 0;
+    quint32 sampleCount = 0;
+    float sampleRate = 0.0f;
+    quint8 encoding = WaveformChunk::Raw;
+    quint32 payloadSize = 0;
+    int segment = 0;      // hastanın segment listesindeki sıra
+    qint64 offset = 0;    // parça başlığının segment içindeki konumu
+};
+
+// Yazım kendi depolama thread'inde (appendChunk slotu) yapılır; Reader'lar tamamlanan
+// parçaları kuyruklu çağrıyla gönderir, acquisition ve GUI thread'i dosya G/Ç'si yapmaz.
+// Aralık okumaları herhangi bir thread'den yapılabilir: dizin kilit altında kopyalanır,
+// yalnızca aralıkla kesişen parçalar okunur ve segmentler belleğe eşlenerek parça
+// doğrudan eşlenmiş sayfalardan çözülür (ara dosya tamponu yoktur).
+class WaveformStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 DefaultSegmentSize = 8 * 1024 * 1024;
+
+    explicit WaveformStore(const QString &directory, qint64 segmentSize = DefaultSegmentSize,
+                           QObject *parent = nullptr);
+    ~WaveformStore() override;
+
+    QString directory() const { return m_directory; }
+
+    // [fromMs, toMs] ile kesişen örnekler; parçalar arası boşlukta yeni aralık başlar
+    QVector<WaveformRange> readRange(int patientId, qint64 fromMs, qint64 toMs) const;
+    // Yalnızca dizin: aralıkla kesişen parçalar (çözme yapılmaz)
+    QVector<WaveformChunkInfo> chunks(int patientId, qint64 fromMs, qint64 toMs) const;
+
+    quint64 chunksWritten() const { return m_chunksWritten.load(std::memory_order_relaxed); }
+    quint64 bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+    quint64 samplesWritten() const { return m_samplesWritten.load(std::memory_order_relaxed); }
+
+public slots:
+    // Depolama thread'inde: samples bir parçanın ham 8 bit örnekleridir
+    void appendChunk(int patientId, qint64 startMs, double sampleRate, const QByteArray &samples);
+    // Açık segment dosyalarını kapatır (kapanışta, bekleyen parçalardan sonra)
+    void closeAll();
+
+signals:
+    void chunkStored(int patientId, qint64 startMs, qint64 endMs);
+
+private:
+    struct Patient {
+        QString directory;
+        QStringList segments;               // segment dosya yolları, sırayla
+        QVector<WaveformChunkInfo> chunks;  // startMs'e göre sıralı
+        qint64 maxDurationMs = 0;           // aralık aramasında geriye bakış payı
+        QFile file;                         // yazılan segment (yalnızca depolama thread'i)
+        qint64 fileSize = 0;
+    };
+
+    // m_mutex almadan çağrılır. İlk erişimde segmentler kilit dışında taranır; create false
+    // ise (okuma yolu) dizini olmayan hasta için girdi oluşturulmaz, nullptr döner.
+    // Girdiler yıkıcıya kadar silinmez; içerikleri m_mutex altında okunur.
+    Patient *patient(int patientId, bool create) const;
+    static void scanSegment(Patient *p, int segment);
+    bool openNextSegment(Patient *p, int patientId);
+    // Kesişen parçaların kopyası; segment yolları ile birlikte
+    QVector<WaveformChunkInfo> findChunks(int patientId, qint64 fromMs, qint64 toMs, QStringList *segments) const;
+
+    QString m_directory;
+    qint64 m_segmentSize;
+
+    mutable QMutex m_mutex; // hasta dizinleri
+    mutable QHash<int, Patient *> m_patients;
+
+    std::atomic<quint64> m_chunksWritten{0};
+    std::atomic<quint64> m_bytesWritten{0};
+    std::atomic<quint64> m_samplesWritten{0};
+};
+
+#endif // WAVEFORMSTORE_H